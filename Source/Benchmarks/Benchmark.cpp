@@ -0,0 +1,33 @@
+/*
+  ==============================================================================
+
+    Benchmark.cpp
+    Created: 17 Oct 2026 4:05:12pm
+    Author:  maxime
+
+  ==============================================================================
+*/
+
+#include "Benchmark.h"
+
+namespace benchmarks
+{
+
+Benchmark::Benchmark(const juce::String& name)
+    : m_name(name)
+{
+    getAllBenchmarks().add(this);
+}
+
+Benchmark::~Benchmark()
+{
+    getAllBenchmarks().removeFirstMatchingValue(this);
+}
+
+juce::Array<Benchmark*>& Benchmark::getAllBenchmarks()
+{
+    static juce::Array<Benchmark*> benchmarks;
+    return benchmarks;
+}
+
+} // namespace benchmarks
@@ -0,0 +1,70 @@
+/*
+  ==============================================================================
+
+    Benchmark.h
+    Created: 17 Oct 2026 4:05:12pm
+    Author:  maxime
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "Engine/Binding.h"
+
+namespace benchmarks
+{
+
+/**
+ * @class benchmarks::Benchmark
+ * @brief Base class of the DSP module benchmarks
+ *
+ * Like juce::UnitTest, every benchmark registers itself in a global list when
+ * constructed, so declaring a static instance is enough for the
+ * BenchmarkRunner to run it.
+ *
+ * The runner calls initialise() once, then prepare() and process() for every
+ * processing context to measure, and finally shutdown().
+ */
+class Benchmark
+{
+public:
+    explicit Benchmark(const juce::String& name);
+    virtual ~Benchmark();
+
+    const juce::String& getName() const noexcept { return m_name; }
+
+//==============================================================================
+    /**
+     * @brief Create the benchmarked module
+     */
+    virtual void initialise(engine::Bindings bindings) = 0;
+    /**
+     * @brief Destroy the benchmarked module
+     */
+    virtual void shutdown() = 0;
+    /**
+     * @brief Prepare the module for a new processing context
+     */
+    virtual void prepare(double sampleRate, int blockSize) = 0;
+    /**
+     * @brief Process one block, this is the only timed method
+     *
+     * @param buffer     A mono buffer filled with the runner input signal
+     * @param numSamples The number of samples to process
+     */
+    virtual void process(juce::AudioBuffer<float>& buffer, int numSamples) = 0;
+
+//==============================================================================
+    /**
+     * @brief Get every registered benchmark
+     */
+    static juce::Array<Benchmark*>& getAllBenchmarks();
+
+private:
+    juce::String        m_name;
+};
+
+} // namespace benchmarks
@@ -0,0 +1,168 @@
+/*
+  ==============================================================================
+
+    BenchmarkRunner.cpp
+    Created: 17 Oct 2026 4:18:40pm
+    Author:  maxime
+
+  ==============================================================================
+*/
+
+#include "BenchmarkRunner.h"
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include "Benchmarks/Benchmark.h"
+#include "Engine/Binding.h"
+
+namespace benchmarks
+{
+
+// The modules run with the same noise range than in the synth, and a fixed
+// seed so two runs measure the exact same work
+constexpr float  BENCHMARK_NOISE_RANGE = 0.03f;
+constexpr juce::uint64 BENCHMARK_NOISE_SEED = 303;
+// Frequency and amplitude of the saw wave fed to the modules
+constexpr double INPUT_FREQUENCY = 110.;
+constexpr float  INPUT_GAIN = 0.5f;
+constexpr int    JSON_FORMAT_VERSION = 1;
+
+BenchmarkRunner::BenchmarkRunner()
+    : m_midiBroker(),
+      m_parameters(m_midiBroker.readParameterSnapshot()),
+      m_noiseGenerator(BENCHMARK_NOISE_RANGE, BENCHMARK_NOISE_SEED),
+      m_signalBus(),
+      m_wavetables(),
+      m_input(),
+      m_buffer()
+{
+    // Nothing to do here
+}
+
+//==============================================================================
+juce::Array<BenchmarkRunner::Result> BenchmarkRunner::runAllBenchmarks()
+{
+    auto results = juce::Array<Result>();
+    auto maxBlockSize = *std::max_element(std::begin(BLOCK_SIZES), std::end(BLOCK_SIZES));
+    auto bindings = engine::Bindings({
+            m_midiBroker.getIdToParameterMap(),
+            m_noiseGenerator,
+            m_signalBus,
+            m_parameters,
+            m_wavetables});
+
+    m_input.setSize(1, maxBlockSize);
+    m_buffer.setSize(1, maxBlockSize);
+    m_signalBus.prepare(maxBlockSize);
+
+    std::cout << juce::String("benchmark").paddedRight(' ', 24)
+              << juce::String("samplerate").paddedLeft(' ', 12)
+              << juce::String("blocksize").paddedLeft(' ', 12)
+              << juce::String("ns/sample").paddedLeft(' ', 12)
+              << juce::String("min").paddedLeft(' ', 12) << std::endl;
+
+    for (auto* benchmark : Benchmark::getAllBenchmarks())
+    {
+        benchmark->initialise(bindings);
+
+        for (auto sampleRate : SAMPLE_RATES)
+        {
+            // The input is a naive saw wave, the same for every block
+            auto* input = m_input.getWritePointer(0);
+            auto phaseDelta = INPUT_FREQUENCY / sampleRate;
+
+            for (auto i = 0; i < maxBlockSize; ++i)
+            {
+                auto phase = std::fmod(i * phaseDelta, 1.);
+                input[i] = INPUT_GAIN * float(2. * phase - 1.);
+            }
+
+            for (auto blockSize : BLOCK_SIZES)
+            {
+                benchmark->prepare(sampleRate, blockSize);
+
+                auto result = Result();
+                result.m_name = benchmark->getName();
+                result.m_sampleRate = sampleRate;
+                result.m_blockSize = blockSize;
+
+                // The first repetition is only used to warm up the caches
+                measure(*benchmark, blockSize);
+                auto measures = std::vector<double>();
+
+                for (auto repetition = 0; repetition < NUM_REPETITIONS; ++repetition)
+                {
+                    measures.push_back(measure(*benchmark, blockSize));
+                }
+
+                std::sort(measures.begin(), measures.end());
+                result.m_nsPerSample = measures[measures.size() / 2];
+                result.m_minNsPerSample = measures.front();
+                results.add(result);
+
+                std::cout << result.m_name.paddedRight(' ', 24)
+                          << juce::String(sampleRate, 0).paddedLeft(' ', 12)
+                          << juce::String(blockSize).paddedLeft(' ', 12)
+                          << juce::String(result.m_nsPerSample, 2).paddedLeft(' ', 12)
+                          << juce::String(result.m_minNsPerSample, 2).paddedLeft(' ', 12)
+                          << std::endl;
+            }
+        }
+
+        benchmark->shutdown();
+    }
+
+    return results;
+}
+
+juce::var BenchmarkRunner::toJson(const juce::Array<Result>& results)
+{
+    auto* root = new juce::DynamicObject();
+    auto resultsArray = juce::Array<juce::var>();
+
+    for (auto& result : results)
+    {
+        auto* object = new juce::DynamicObject();
+        object->setProperty("name", result.m_name);
+        object->setProperty("samplerate", result.m_sampleRate);
+        object->setProperty("blocksize", result.m_blockSize);
+        object->setProperty("ns_per_sample", result.m_nsPerSample);
+        object->setProperty("min_ns_per_sample", result.m_minNsPerSample);
+        resultsArray.add(juce::var(object));
+    }
+
+    root->setProperty("format_version", JSON_FORMAT_VERSION);
+    root->setProperty("version", ProjectInfo::versionString);
+    root->setProperty("date", juce::Time::getCurrentTime().toISO8601(true));
+    root->setProperty("cpu", juce::SystemStats::getCpuModel());
+    root->setProperty("num_cpus", juce::SystemStats::getNumCpus());
+    root->setProperty("samples_per_repetition", SAMPLES_PER_REPETITION);
+    root->setProperty("num_repetitions", NUM_REPETITIONS);
+    root->setProperty("results", resultsArray);
+
+    return juce::var(root);
+}
+
+//==============================================================================
+double BenchmarkRunner::measure(Benchmark& benchmark, int blockSize)
+{
+    auto numBlocks = SAMPLES_PER_REPETITION / blockSize;
+    auto startTicks = juce::Time::getHighResolutionTicks();
+
+    // The copy of the input is included in the measure, but its cost is
+    // negligible compared to any of the modules
+    for (auto block = 0; block < numBlocks; ++block)
+    {
+        m_buffer.copyFrom(0, 0, m_input, 0, 0, blockSize);
+        benchmark.process(m_buffer, blockSize);
+    }
+
+    auto endTicks = juce::Time::getHighResolutionTicks();
+    auto seconds = juce::Time::highResolutionTicksToSeconds(endTicks - startTicks);
+
+    return seconds * 1e9 / (numBlocks * blockSize);
+}
+
+} // namespace benchmarks
@@ -0,0 +1,83 @@
+/*
+  ==============================================================================
+
+    BenchmarkRunner.h
+    Created: 17 Oct 2026 4:18:40pm
+    Author:  maxime
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "Control/MidiBroker.h"
+#include "Engine/NoiseGenerator.h"
+#include "Engine/SignalBus.h"
+#include "Engine/Oscillators/WavetableBank.h"
+
+namespace benchmarks
+{
+
+class Benchmark;
+
+/**
+ * @class benchmarks::BenchmarkRunner
+ * @brief Runs every registered Benchmark over all the processing contexts
+ *
+ * Each benchmark is measured for every combination of SAMPLE_RATES and
+ * BLOCK_SIZES. A measure processes SAMPLES_PER_REPETITION samples block after
+ * block, and is repeated NUM_REPETITIONS times after one warm up repetition.
+ * The median and the min cost are reported in nanoseconds per sample.
+ *
+ * The modules are bound to the parameters loaded by a MidiBroker, so they run
+ * with the same configuration than the synth.
+ */
+class BenchmarkRunner
+{
+public:
+    /**
+     * @brief The cost of a benchmark for a given processing context
+     */
+    struct Result
+    {
+        juce::String    m_name;
+        double          m_sampleRate = 0.;
+        int             m_blockSize = 0;
+        double          m_nsPerSample = 0.;     // Median over the repetitions
+        double          m_minNsPerSample = 0.;
+    };
+
+    static constexpr int    BLOCK_SIZES[] = {16, 32, 64, 128, 256, 512, 1024};
+    static constexpr double SAMPLE_RATES[] = {44100., 48000., 96000., 192000.};
+    static constexpr int    SAMPLES_PER_REPETITION = 1 << 16;
+    static constexpr int    NUM_REPETITIONS = 5;
+
+//==============================================================================
+    BenchmarkRunner();
+
+    /**
+     * @brief Run all the benchmarks and print their results
+     */
+    juce::Array<Result> runAllBenchmarks();
+
+    /**
+     * @brief Convert results to a json object, with some infos on the machine
+     */
+    static juce::var toJson(const juce::Array<Result>& results);
+
+private:
+    double measure(Benchmark& benchmark, int blockSize);
+
+//==============================================================================
+    control::MidiBroker                 m_midiBroker;
+    control::ParameterSnapshot          m_parameters;
+    engine::NoiseGenerator              m_noiseGenerator;
+    engine::SignalBus                   m_signalBus;
+    engine::WavetableBank               m_wavetables;
+    juce::AudioBuffer<float>            m_input;
+    juce::AudioBuffer<float>            m_buffer;
+};
+
+} // namespace benchmarks
@@ -0,0 +1,112 @@
+/*
+  ==============================================================================
+
+    ControlBenchmarks.cpp
+    Created: 17 Oct 2026 11:37:52pm
+    Author:  maxime
+
+  ==============================================================================
+*/
+
+#include "Benchmarks/Benchmark.h"
+
+#include "Control/MidiBroker.h"
+
+#include "Utils/Identifiers.h"
+#include "Utils/Parameters.h"
+
+namespace benchmarks
+{
+
+// A controller sending knob data as fast as it can
+constexpr double CONTROLLER_RATE_HZ = 1000.;
+
+//==============================================================================
+/**
+ * @brief Cost of the midi thread handling a dense stream of controller
+ * messages, and of the audio thread reading the resulting snapshots
+ *
+ * The cost is still reported per sample : it is the cost of the messages
+ * received by the synth during that sample.
+ */
+class MidiBrokerControllersBenchmark : public Benchmark
+{
+public:
+    /**
+     * @param useHighResolution Send 14-bit absolute values instead of relative
+     * ones
+     */
+    MidiBrokerControllersBenchmark(bool useHighResolution)
+        : Benchmark(useHighResolution ? "MidiBroker 14-bit controllers"
+                : "MidiBroker controllers"),
+          m_useHighResolution(useHighResolution) {}
+
+    void initialise(engine::Bindings) override
+    {
+        m_broker = std::make_unique<control::MidiBroker>();
+        m_broker->setAbsoluteControls(m_useHighResolution);
+        m_messages.clearQuick();
+
+        auto settings = parameters::Parameter::loadParameters().m_parameters;
+        auto channel = m_broker->getMidiChannel();
+
+        if (m_useHighResolution)
+        {
+            // A slow sweep of the cutoff, sent as MSB + LSB pairs
+            auto cutoffCC = settings.at(identifiers::controls::CUTOFF).m_cc;
+
+            for (auto value = 0; value < 16384; value += 37)
+            {
+                m_messages.add(juce::MidiMessage::controllerEvent(channel, cutoffCC, value >> 7));
+                m_messages.add(juce::MidiMessage::controllerEvent(channel, cutoffCC + 32,
+                        value & 0x7f));
+            }
+        }
+        else
+        {
+            // Every parameter moved back and forth
+            for (auto& pair : settings)
+            {
+                m_messages.add(juce::MidiMessage::controllerEvent(channel, pair.second.m_cc, 65));
+                m_messages.add(juce::MidiMessage::controllerEvent(channel, pair.second.m_cc, 63));
+            }
+        }
+    }
+
+    void shutdown() override { m_broker.reset(); }
+
+    void prepare(double sampleRate, int) override
+    {
+        m_messagesPerSample = CONTROLLER_RATE_HZ / sampleRate;
+        m_pendingMessages = 0.;
+        m_nextMessage = 0;
+    }
+
+    void process(juce::AudioBuffer<float>&, int numSamples) override
+    {
+        m_pendingMessages += m_messagesPerSample * numSamples;
+
+        for (; m_pendingMessages >= 1.; m_pendingMessages -= 1.)
+        {
+            m_broker->handleIncomingMidiMessage(nullptr, m_messages.getReference(m_nextMessage));
+            m_nextMessage = (m_nextMessage + 1) % m_messages.size();
+        }
+
+        // What the engine does once per callback
+        juce::ignoreUnused(m_broker->readParameterSnapshot());
+    }
+
+private:
+    std::unique_ptr<control::MidiBroker>            m_broker;
+    juce::Array<juce::MidiMessage>                  m_messages;
+    double                                          m_messagesPerSample = 0.;
+    double                                          m_pendingMessages = 0.;
+    int                                             m_nextMessage = 0;
+    bool                                            m_useHighResolution;
+};
+
+//==============================================================================
+static MidiBrokerControllersBenchmark   MIDI_BROKER_CONTROLLERS_BENCHMARK(false);
+static MidiBrokerControllersBenchmark   MIDI_BROKER_HIGH_RES_CONTROLLERS_BENCHMARK(true);
+
+} // namespace benchmarks
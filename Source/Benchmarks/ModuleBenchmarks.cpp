@@ -0,0 +1,498 @@
+/*
+  ==============================================================================
+
+    ModuleBenchmarks.cpp
+    Created: 17 Oct 2026 4:41:27pm
+    Author:  maxime
+
+  ==============================================================================
+*/
+
+#include "Benchmarks/Benchmark.h"
+
+#include "Engine/Oscillators/WavetableOscillator.h"
+#include "Engine/Oscillators/DualOscillator.h"
+#include "Engine/Oscillators/UnisonStack.h"
+#include "Engine/VoicePool.h"
+#include "Engine/Envelopes/VCAEnvelope.h"
+#include "Engine/Envelopes/AccentEnvelope.h"
+#include "Engine/Filter/Open303/rosic_TeeBeeFilter.h"
+#include "Engine/Filter/OberheimLadder.h"
+#include "Engine/Filter/Filter.h"
+
+#include "Utils/Parameters.h"
+#include "Utils/Utils.h"
+
+namespace benchmarks
+{
+
+constexpr float  OSC_FREQUENCY = 110.f;
+constexpr double FILTER_CUTOFF = 1000.;
+constexpr double TEEBEE_RESONANCE = 50.;
+constexpr float  OBERHEIM_RESONANCE = 4.f;
+constexpr double TEEBEE_FEEDBACK_HIGHPASS = 180.;
+// The unison stack renders all its voices and the sub
+constexpr float  UNISON_DETUNE_CENTS = 15.f;
+constexpr float  UNISON_SUB_LEVEL = 0.5f;
+constexpr float  UNISON_MORPH_POSITION = 0.5f;
+// The voice pool holds a chord of CHORD_SIZE notes
+constexpr int    CHORD_SIZE = 4;
+constexpr int    CHORD_NOTES[CHORD_SIZE] = {45, 48, 52, 55};
+// The envelopes are retriggered regularly to go through all their states
+constexpr double NOTE_LENGTH_S = 0.25;
+
+/**
+ * @brief Helper alternating note on and note off every NOTE_LENGTH_S
+ */
+class NoteClock
+{
+public:
+    void prepare(double sampleRate)
+    {
+        m_noteLength = int(NOTE_LENGTH_S * sampleRate);
+        m_position = 0;
+    }
+
+    /**
+     * @brief Advance the clock and tells if a note on or a note off happened
+     * @return int 1 for note on, -1 for note off, 0 otherwise
+     */
+    int advance(int numSamples)
+    {
+        auto previous = m_position;
+        m_position = (m_position + numSamples) % (2 * m_noteLength);
+
+        if (previous >= m_noteLength && m_position < m_noteLength) { return 1; }
+        if (previous < m_noteLength && m_position >= m_noteLength) { return -1; }
+        return 0;
+    }
+
+private:
+    int m_noteLength = 1;
+    int m_position = 0;
+};
+
+//==============================================================================
+class WavetableOscBenchmark : public Benchmark
+{
+public:
+    WavetableOscBenchmark() : Benchmark("WavetableOscillator") {}
+
+    void initialise(engine::Bindings bindings) override
+    {
+        utils::waveform::loadWavetableFromBinaryWaveFile(m_wavetable,
+                BinaryData::waveform_saw_wav, BinaryData::waveform_saw_wavSize);
+        utils::waveform::buildMipmaps(m_wavetable);
+        m_osc = std::make_unique<engine::WavetableOscillator>(m_wavetable, bindings);
+    }
+
+    void shutdown() override { m_osc.reset(); }
+
+    void prepare(double sampleRate, int blockSize) override
+    {
+        m_osc->prepare(float(sampleRate), blockSize);
+        m_osc->setFrequency(OSC_FREQUENCY, true);
+    }
+
+    void process(juce::AudioBuffer<float>& buffer, int numSamples) override
+    {
+        auto block = juce::dsp::AudioBlock<float>(buffer).getSubBlock(0, size_t(numSamples));
+        m_osc->process(juce::dsp::ProcessContextReplacing<float>(block));
+    }
+
+private:
+    juce::AudioSampleBuffer                         m_wavetable;
+    std::unique_ptr<engine::WavetableOscillator>    m_osc;
+};
+
+//==============================================================================
+class DualOscBenchmark : public Benchmark
+{
+public:
+    /**
+     * @param name   The name of the benchmark
+     * @param kernel The way the oscillator renders its waveforms
+     */
+    DualOscBenchmark(const juce::String& name, engine::DualOscillator::Kernel kernel)
+        : Benchmark(name),
+          m_kernel(kernel) {}
+
+    void initialise(engine::Bindings bindings) override
+    {
+        m_osc = std::make_unique<engine::DualOscillator>(bindings, m_kernel);
+    }
+
+    void shutdown() override { m_osc.reset(); }
+
+    void prepare(double sampleRate, int blockSize) override
+    {
+        m_osc->prepare(float(sampleRate), blockSize);
+        m_osc->setFrequency(OSC_FREQUENCY, true);
+    }
+
+    void process(juce::AudioBuffer<float>& buffer, int numSamples) override
+    {
+        m_osc->process(buffer, 0, numSamples);
+    }
+
+private:
+    std::unique_ptr<engine::DualOscillator>         m_osc;
+    engine::DualOscillator::Kernel                  m_kernel;
+};
+
+//==============================================================================
+class UnisonStackBenchmark : public Benchmark
+{
+public:
+    /**
+     * @param analytic Compute the waveforms instead of reading the wavetables
+     */
+    UnisonStackBenchmark(bool analytic)
+        : Benchmark(analytic ? "UnisonStack polyBLEP" : "UnisonStack"),
+          m_analytic(analytic) {}
+
+    void initialise(engine::Bindings bindings) override
+    {
+        m_wavetables = &bindings.r_wavetables;
+        m_stack = std::make_unique<engine::UnisonStack>(bindings, m_analytic);
+        m_stack->setVoices(engine::UnisonStack::MAX_UNISON_VOICES, UNISON_DETUNE_CENTS,
+                UNISON_SUB_LEVEL);
+    }
+
+    void shutdown() override { m_stack.reset(); }
+
+    void prepare(double sampleRate, int blockSize) override
+    {
+        m_stack->prepare(float(sampleRate), blockSize);
+        m_stack->setFrequency(OSC_FREQUENCY, true);
+        m_positions.assign(size_t(blockSize), UNISON_MORPH_POSITION);
+    }
+
+    void process(juce::AudioBuffer<float>& buffer, int numSamples) override
+    {
+        m_stack->process(*m_wavetables, m_positions.data(), 0.5f,
+                buffer.getWritePointer(0), numSamples);
+    }
+
+private:
+    const engine::WavetableBank*                    m_wavetables = nullptr;
+    std::unique_ptr<engine::UnisonStack>            m_stack;
+    std::vector<float>                              m_positions;
+    bool                                            m_analytic;
+};
+
+//==============================================================================
+class VoicePoolBenchmark : public Benchmark
+{
+public:
+    VoicePoolBenchmark() : Benchmark("VoicePool") {}
+
+    void initialise(engine::Bindings bindings) override
+    {
+        m_pool = std::make_unique<engine::VoicePool>(CHORD_SIZE, bindings);
+    }
+
+    void shutdown() override { m_pool.reset(); }
+
+    void prepare(double sampleRate, int blockSize) override
+    {
+        m_pool->prepare(sampleRate, blockSize);
+
+        // Start the chord outside of the measure
+        auto buffer = juce::AudioBuffer<float>(1, blockSize);
+        auto chord = juce::MidiBuffer();
+
+        for (auto note : CHORD_NOTES)
+        {
+            chord.addEvent(juce::MidiMessage::noteOn(1, note, 0.8f), 0);
+        }
+
+        m_pool->renderNextBlock(buffer, chord, 0, blockSize);
+    }
+
+    void process(juce::AudioBuffer<float>& buffer, int numSamples) override
+    {
+        m_pool->renderNextBlock(buffer, m_noMidi, 0, numSamples);
+    }
+
+private:
+    std::unique_ptr<engine::VoicePool>              m_pool;
+    juce::MidiBuffer                                m_noMidi;
+};
+
+//==============================================================================
+class VCAEnvelopeBenchmark : public Benchmark
+{
+public:
+    VCAEnvelopeBenchmark() : Benchmark("VCAEnvelope") {}
+
+    void initialise(engine::Bindings bindings) override
+    {
+        m_envelope = std::make_unique<engine::VCAEnvelope>(bindings);
+    }
+
+    void shutdown() override { m_envelope.reset(); }
+
+    void prepare(double sampleRate, int) override
+    {
+        m_envelope->setSampleRate(sampleRate);
+        m_envelope->reset();
+        m_envelope->noteOn();
+        m_clock.prepare(sampleRate);
+    }
+
+    void process(juce::AudioBuffer<float>& buffer, int numSamples) override
+    {
+        auto event = m_clock.advance(numSamples);
+        if (event > 0) { m_envelope->noteOn(); }
+        if (event < 0) { m_envelope->noteOff(); }
+
+        m_envelope->applyAmpEnvelopeToBuffer(buffer, 0, numSamples);
+    }
+
+private:
+    std::unique_ptr<engine::VCAEnvelope>            m_envelope;
+    NoteClock                                       m_clock;
+};
+
+//==============================================================================
+class AccentEnvelopeBenchmark : public Benchmark
+{
+public:
+    AccentEnvelopeBenchmark() : Benchmark("AccentEnvelope") {}
+
+    void initialise(engine::Bindings bindings) override
+    {
+        m_envelope = std::make_unique<engine::AccentEnvelope>(bindings);
+    }
+
+    void shutdown() override { m_envelope.reset(); }
+
+    void prepare(double sampleRate, int) override
+    {
+        m_envelope->setSampleRate(sampleRate);
+        m_envelope->reset();
+        m_envelope->noteOn(1.f);
+        m_clock.prepare(sampleRate);
+    }
+
+    void process(juce::AudioBuffer<float>&, int numSamples) override
+    {
+        auto event = m_clock.advance(numSamples);
+        if (event > 0) { m_envelope->noteOn(1.f); }
+        if (event < 0) { m_envelope->noteOff(); }
+
+        m_envelope->nextValue(0, numSamples);
+    }
+
+private:
+    std::unique_ptr<engine::AccentEnvelope>         m_envelope;
+    NoteClock                                       m_clock;
+};
+
+//==============================================================================
+class TeeBeeFilterBenchmark : public Benchmark
+{
+public:
+    /**
+     * @param useBlockProcessing Use processBlock() instead of getSample()
+     */
+    TeeBeeFilterBenchmark(bool useBlockProcessing)
+        : Benchmark(useBlockProcessing ? "TeeBeeFilter block" : "TeeBeeFilter"),
+          m_useBlockProcessing(useBlockProcessing) {}
+
+    void initialise(engine::Bindings) override
+    {
+        m_filter = std::make_unique<rosic::TeeBeeFilter>();
+        m_filter->setMode(rosic::TeeBeeFilter::TB_303);
+        m_filter->setFeedbackHighpassCutoff(TEEBEE_FEEDBACK_HIGHPASS);
+    }
+
+    void shutdown() override { m_filter.reset(); }
+
+    void prepare(double sampleRate, int) override
+    {
+        m_filter->setSampleRate(sampleRate);
+        m_filter->setCutoff(FILTER_CUTOFF);
+        m_filter->setResonance(TEEBEE_RESONANCE);
+        m_filter->reset();
+    }
+
+    void process(juce::AudioBuffer<float>& buffer, int numSamples) override
+    {
+        auto* data = buffer.getWritePointer(0);
+
+        if (m_useBlockProcessing)
+        {
+            m_filter->processBlock(data, numSamples);
+            return;
+        }
+
+        for (auto i = 0; i < numSamples; ++i)
+        {
+            data[i] = float(m_filter->getSample(data[i]));
+        }
+    }
+
+private:
+    std::unique_ptr<rosic::TeeBeeFilter>            m_filter;
+    bool                                            m_useBlockProcessing;
+};
+
+//==============================================================================
+class OberheimFilterBenchmark : public Benchmark
+{
+public:
+    OberheimFilterBenchmark() : Benchmark("OberheimLadder") {}
+
+    void initialise(engine::Bindings) override {}
+
+    void shutdown() override {}
+
+    void prepare(double sampleRate, int) override
+    {
+        m_filter.prepare(float(sampleRate));
+        m_filter.setCutoff(float(FILTER_CUTOFF));
+        m_filter.setResonance(OBERHEIM_RESONANCE);
+    }
+
+    void process(juce::AudioBuffer<float>& buffer, int numSamples) override
+    {
+        m_filter.process(buffer.getWritePointer(0), numSamples);
+    }
+
+private:
+    engine::OberheimLadder<float>                   m_filter;
+};
+
+//==============================================================================
+class FilterBenchmark : public Benchmark
+{
+public:
+    /**
+     * @param oversamplingFactor The oversampling of the filters, 1, 2 or 4
+     */
+    FilterBenchmark(int oversamplingFactor)
+        : Benchmark("Filter " + juce::String(oversamplingFactor) + "x"),
+          m_oversamplingFactor(oversamplingFactor) {}
+
+    void initialise(engine::Bindings bindings) override
+    {
+        m_filter = std::make_unique<engine::Filter>(bindings, m_oversamplingFactor);
+    }
+
+    void shutdown() override { m_filter.reset(); }
+
+    void prepare(double sampleRate, int blockSize) override
+    {
+        m_filter->prepare(float(sampleRate), blockSize);
+        m_filter->reset();
+    }
+
+    void process(juce::AudioBuffer<float>& buffer, int numSamples) override
+    {
+        auto block = juce::dsp::AudioBlock<float>(buffer).getSubBlock(0, size_t(numSamples));
+        auto context = juce::dsp::ProcessContextReplacing<float>(block);
+        m_filter->process(context);
+    }
+
+private:
+    std::unique_ptr<engine::Filter>                 m_filter;
+    int                                             m_oversamplingFactor;
+};
+
+//==============================================================================
+class LimiterBenchmark : public Benchmark
+{
+public:
+    LimiterBenchmark() : Benchmark("Limiter") {}
+
+    void initialise(engine::Bindings) override
+    {
+        m_limiter.setRelease(parameters::values::LIMITER_RELEASE_MS);
+        m_limiter.setThreshold(parameters::values::LIMITER_THRESHOLD_DB);
+    }
+
+    void shutdown() override { m_limiter.reset(); }
+
+    void prepare(double sampleRate, int blockSize) override
+    {
+        m_limiter.prepare({sampleRate, juce::uint32(blockSize), 1});
+    }
+
+    void process(juce::AudioBuffer<float>& buffer, int numSamples) override
+    {
+        auto block = juce::dsp::AudioBlock<float>(buffer).getSubBlock(0, size_t(numSamples));
+        m_limiter.process(juce::dsp::ProcessContextReplacing<float>(block));
+    }
+
+private:
+    juce::dsp::Limiter<float>                       m_limiter;
+};
+
+//==============================================================================
+class NoiseGeneratorBenchmark : public Benchmark
+{
+public:
+    /**
+     * @param useBlockFill Use fillNoiseFactors() instead of getNoiseFactor()
+     */
+    NoiseGeneratorBenchmark(bool useBlockFill)
+        : Benchmark(useBlockFill ? "NoiseGenerator block" : "NoiseGenerator"),
+          m_useBlockFill(useBlockFill) {}
+
+    void initialise(engine::Bindings bindings) override
+    {
+        m_noiseGenerator = std::make_unique<engine::NoiseGenerator>(
+                bindings.r_noiseGenerator.fork(0));
+    }
+
+    void shutdown() override { m_noiseGenerator.reset(); }
+
+    void prepare(double, int) override {}
+
+    void process(juce::AudioBuffer<float>& buffer, int numSamples) override
+    {
+        auto* data = buffer.getWritePointer(0);
+
+        if (m_useBlockFill)
+        {
+            m_noiseGenerator->fillNoiseFactors(data, numSamples);
+            return;
+        }
+
+        for (auto i = 0; i < numSamples; ++i)
+        {
+            data[i] = m_noiseGenerator->getNoiseFactor();
+        }
+    }
+
+private:
+    std::unique_ptr<engine::NoiseGenerator>         m_noiseGenerator;
+    bool                                            m_useBlockFill;
+};
+
+//==============================================================================
+static WavetableOscBenchmark     WAVETABLE_OSC_BENCHMARK;
+static DualOscBenchmark          DUAL_OSC_BENCHMARK("DualOscillator",
+        engine::DualOscillator::Kernel::wavetable);
+static DualOscBenchmark          DUAL_OSC_SIMD_BENCHMARK("DualOscillator SIMD",
+        engine::DualOscillator::Kernel::wavetableSIMD);
+static DualOscBenchmark          DUAL_OSC_POLYBLEP_BENCHMARK("DualOscillator polyBLEP",
+        engine::DualOscillator::Kernel::analytic);
+static UnisonStackBenchmark      UNISON_STACK_BENCHMARK(false);
+static UnisonStackBenchmark      UNISON_STACK_POLYBLEP_BENCHMARK(true);
+static VoicePoolBenchmark        VOICE_POOL_BENCHMARK;
+static VCAEnvelopeBenchmark      VCA_ENVELOPE_BENCHMARK;
+static AccentEnvelopeBenchmark   ACCENT_ENVELOPE_BENCHMARK;
+static TeeBeeFilterBenchmark     TEEBEE_FILTER_BENCHMARK(false);
+static TeeBeeFilterBenchmark     TEEBEE_FILTER_BLOCK_BENCHMARK(true);
+static OberheimFilterBenchmark   OBERHEIM_FILTER_BENCHMARK;
+static FilterBenchmark           FILTER_BENCHMARK(1);
+static FilterBenchmark           FILTER_2X_BENCHMARK(2);
+static FilterBenchmark           FILTER_4X_BENCHMARK(4);
+static LimiterBenchmark          LIMITER_BENCHMARK;
+static NoiseGeneratorBenchmark   NOISE_GENERATOR_BENCHMARK(false);
+static NoiseGeneratorBenchmark   NOISE_GENERATOR_BLOCK_BENCHMARK(true);
+
+} // namespace benchmarks
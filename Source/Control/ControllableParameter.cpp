@@ -18,7 +18,7 @@ namespace control
  * @brief Pimpl idiom implementation
  * 
  */
-struct ControllableParameter::Impl : public juce::ChangeBroadcaster
+struct ControllableParameter::Impl
 {
     Impl(float initValue, float minValue, float maxValue, ScaleType scale, 
             int discretRange, float minPlusOneValue)
@@ -26,7 +26,7 @@ struct ControllableParameter::Impl : public juce::ChangeBroadcaster
           m_precomputedValues(),
           m_maxValue(maxValue),
           m_minValue(minValue),
-          m_currentDiscretValue(0)
+          m_currentPosition(0.f)
     {
         jassert(discretRange > 0);
         jassert(minValue < maxValue);
@@ -40,15 +40,15 @@ struct ControllableParameter::Impl : public juce::ChangeBroadcaster
         switch (scale)
         {
         case ScaleType::exponential:
-            m_currentDiscretValue.set(precomputeExpValues(initValue));
+            m_currentPosition.set(float(precomputeExpValues(initValue)));
             break;
         
         case ScaleType::logarithmic:
-            m_currentDiscretValue.set(precomputeLogValues(initValue, minPlusOneValue));
+            m_currentPosition.set(float(precomputeLogValues(initValue, minPlusOneValue)));
             break;
 
         default:
-            m_currentDiscretValue.set(precomputeLinearValues(initValue, minPlusOneValue));
+            m_currentPosition.set(float(precomputeLinearValues(initValue, minPlusOneValue)));
             break;
         }
     }
@@ -60,13 +60,13 @@ struct ControllableParameter::Impl : public juce::ChangeBroadcaster
         m_precomputedValues[0] = m_minValue;
         m_precomputedValues[m_discretRange - 1] = m_maxValue;
 
-        auto step = (m_maxValue - m_minValue) / m_discretRange;
-        auto base = m_minValue;
+        // Evenly spaced from the min to the max, both included
+        auto step = double(m_maxValue - m_minValue) / juce::jmax(m_discretRange - 1, 1);
         int discretInitValue = 0;
 
         for (auto i = 1; i < m_discretRange-1; ++i)
         {
-            base += step;
+            auto base = float(m_minValue + i * step);
             m_precomputedValues[i] = base;
             if (base <= initValue)
             {
@@ -166,15 +166,33 @@ struct ControllableParameter::Impl : public juce::ChangeBroadcaster
         return discretInitValue;
     }
 
+    /**
+     * @brief Linear interpolation btw the two precomputed values around the
+     * position, exact for a whole position
+     */
+    float interpolate(float position) const noexcept
+    {
+        auto index = juce::jlimit(0, m_discretRange - 1, int(position));
+        auto fraction = position - float(index);
+
+        if (index == m_discretRange - 1 || fraction <= 0.f)
+        {
+            return m_precomputedValues[index];
+        }
+
+        return m_precomputedValues[index] 
+                + fraction * (m_precomputedValues[index + 1] - m_precomputedValues[index]);
+    }
+
     // Unmutable members
     int                                 m_discretRange;
     std::vector<float>                  m_precomputedValues;
     float                               m_maxValue;
     float                               m_minValue;
 
-    // Mutable members
-    juce::Atomic<int>                   m_currentDiscretValue;
-    juce::Atomic<float>                 m_currentRatio;
+    // Mutable members, the position in the precomputed values. A whole number
+    // unless it was set with setRatio()
+    juce::Atomic<float>                 m_currentPosition;
 };
 
 //==============================================================================
@@ -193,11 +211,6 @@ ControllableParameter::ControllableParameter()
 }
 
 //==============================================================================
-bool ControllableParameter::operator==(juce::ChangeBroadcaster* source) const
-{
-    return dynamic_cast<Impl*>(source) == m_impl.get();
-}
-
 bool ControllableParameter::isValid() const noexcept
 {
     return m_impl != nullptr;
@@ -209,7 +222,7 @@ float ControllableParameter::getCurrentValue() const noexcept
 
     if (m_impl != nullptr)
     {
-        return m_impl->m_precomputedValues[m_impl->m_currentDiscretValue.get()];
+        return m_impl->interpolate(m_impl->m_currentPosition.get());
     }
 
     return -1.0; // To avoid potential division by zero
@@ -221,7 +234,7 @@ int ControllableParameter::getCurrentDiscretValue() const noexcept
     
     if (m_impl != nullptr)
     {
-        return m_impl->m_currentDiscretValue.get();
+        return juce::roundToInt(m_impl->m_currentPosition.get());
     }
     return 0;
 }
@@ -232,7 +245,7 @@ float ControllableParameter::getUnscaledRatioForCurrentValue() const noexcept
 
     if (m_impl != nullptr)
     {
-        return float(m_impl->m_currentDiscretValue.get()) / (m_impl->m_discretRange - 1);
+        return m_impl->m_currentPosition.get() / (m_impl->m_discretRange - 1);
     }
 
     return 0.0;
@@ -257,8 +270,7 @@ float ControllableParameter::getScaledValueForUnscaledRatio(float ratio) const n
 
     if (m_impl != nullptr && ratio >= 0.0 && ratio <= 1.0)
     {
-        int discretIndex = (m_impl->m_discretRange - 1) * ratio;
-        return m_impl->m_precomputedValues[discretIndex];
+        return m_impl->interpolate((m_impl->m_discretRange - 1) * ratio);
     }
 
     return -1.0; // To avoid potential division by zero
@@ -271,7 +283,7 @@ void ControllableParameter::updateCurrentDiscretValue(int delta)
 
     if (m_impl != nullptr && delta != 0)
     {
-        auto newDiscretValue = m_impl->m_currentDiscretValue.get() + delta;
+        auto newDiscretValue = juce::roundToInt(m_impl->m_currentPosition.get()) + delta;
 
         if (newDiscretValue > m_impl->m_discretRange - 1)
         {
@@ -282,8 +294,7 @@ void ControllableParameter::updateCurrentDiscretValue(int delta)
             newDiscretValue = 0;
         }
 
-        m_impl->m_currentDiscretValue.set(newDiscretValue);
-        m_impl->sendChangeMessage();
+        m_impl->m_currentPosition.set(float(newDiscretValue));
     }
 }
 
@@ -293,19 +304,19 @@ void ControllableParameter::setDiscretValue(int newValue)
 
     if (m_impl != nullptr)
     {
-        m_impl->m_currentDiscretValue.set(newValue);
-        m_impl->sendChangeMessage();
+        m_impl->m_currentPosition.set(float(newValue));
     }
 }
 
-void ControllableParameter::addListener(juce::ChangeListener* listener)
+void ControllableParameter::setRatio(float ratio)
 {
     jassert(m_impl != nullptr);
+    jassert(ratio >= 0.0 && ratio <= 1.0);
 
     if (m_impl != nullptr)
     {
-        juce::MessageManagerLock lock;
-        m_impl->addChangeListener(listener);
+        auto position = juce::jlimit(0.f, 1.f, ratio) * (m_impl->m_discretRange - 1);
+        m_impl->m_currentPosition.set(position);
     }
 }
 
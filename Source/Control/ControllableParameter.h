@@ -22,8 +22,9 @@ namespace control
  * A ControllableParameter precomputes all the possibles values for the 
  * parameter and keeps track of the current value.
  * 
- * Any module can hold how many he needs, and can become an ChangeListener to
- * react to a value change by calling addListener()
+ * Any module can hold how many he needs. The audio modules do not read it
+ * directly : the midi thread publishes the values of every parameter in a
+ * control::ParameterSnapshot, which the engine reads once per callback.
  * 
  * This class uses pass by value semantic, each parameter should be creating 
  * only once and then passed and copied. Most methods are thread-safes.
@@ -32,6 +33,11 @@ namespace control
  * distributed either linearly, exponantially or logarithmicly among the value
  * range provided in the constructor.
  * 
+ * The relative controls move the parameter from one discret value to another.
+ * The high resolution controls (14-bit, NRPN) can set it anywhere in its
+ * range with setRatio(), the value is then interpolated btw the two nearest
+ * discret values.
+ * 
  * The default contructor should not be used explicitely and is only available
  * for conveniency.
  */
@@ -70,10 +76,6 @@ public:
             float minPlusOneValue=0.0);
 
 //==============================================================================
-    /**
-     * @brief Usefull to identify which parameters has changed
-     */
-    bool operator==(juce::ChangeBroadcaster* source) const;
     /**
      * @brief Test if the object is a valid or an empty one
      */
@@ -83,7 +85,8 @@ public:
      */
     float getCurrentValue() const noexcept;
     /**
-     * @brief Get the current discret value of the parameter
+     * @brief Get the current discret value of the parameter, the nearest one
+     * if the parameter was set with setRatio()
      */
     int getCurrentDiscretValue() const noexcept;
     /**
@@ -99,7 +102,8 @@ public:
      */
     int getDiscretRange() const noexcept;
     /**
-     * @brief Get the precomputed value for the given ratio
+     * @brief Get the value for the given ratio, interpolated btw the
+     * precomputed ones
      * 
      * @param ratio Btw 0 and 1. Position in the precomputed scaled (linear/
      * logaritmic/exponential) range. 0 the min, 1 the max.
@@ -123,16 +127,14 @@ public:
      */
     void setDiscretValue(int newValue);
     /**
-     * @brief Add a listener to the parameter to be noticed when the value
-     * changes
-     * @note This method is NOT entirely thread-safe, avoid calling it on
-     * message/audio thread without further investigation on 
-     * juce::ChangeBroadcaster methods
+     * @brief Set the current value anywhere in the range, not only on a 
+     * discret value
+     * @note This function is NOT safe to call from the audio thread
      * 
-     * @param listener The new listener to the parameter
+     * @param ratio Btw 0 and 1. Position in the precomputed scaled (linear/
+     * logaritmic/exponential) range. 0 the min, 1 the max.
      */
-    void addListener(juce::ChangeListener* listener);
-
+    void setRatio(float ratio);
 
 private:
 //==============================================================================
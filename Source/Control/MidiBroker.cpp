@@ -16,34 +16,93 @@
 namespace control
 {
 
-const auto presetPrefix = juce::String("preset_");
+// Controllers of the 14-bit and NRPN messages
+constexpr auto LSB_CONTROLLER_OFFSET = 32;
+constexpr auto DATA_ENTRY_MSB = 6;
+constexpr auto DATA_ENTRY_LSB = 38;
+constexpr auto DATA_INCREMENT = 96;
+constexpr auto DATA_DECREMENT = 97;
+constexpr auto NRPN_LSB = 98;
+constexpr auto NRPN_MSB = 99;
+constexpr auto RPN_LSB = 100;
+constexpr auto RPN_MSB = 101;
+constexpr auto NULL_NUMBER = 127;
+constexpr auto MAX_14BIT_VALUE = 16383.f;
+
+/**
+ * @brief The ratio of a 14-bit value
+ */
+inline float get14BitRatio(int msb, int lsb)
+{
+    return float((msb << 7) | lsb) / MAX_14BIT_VALUE;
+}
+
+/**
+ * @brief The ratio of a MSB received without its LSB, the MSB is repeated in
+ * the LSB so a 7-bit controller can reach the whole range
+ */
+inline float get14BitRatio(int msb)
+{
+    return get14BitRatio(msb, msb);
+}
 
 MidiBroker::MidiBroker()
-    : m_globalChannel(-1),
+    : m_noteFifo(NOTE_FIFO_SIZE),
+      m_noteEvents(),
+      m_globalChannel(-1),
       m_savePatchCC(-1),
+      m_numVoices(1),
+      m_noiseSeed(0),
+      m_absoluteControls(false),
+      m_controllerMSB(),
+      m_nrpnNumberMSB(NULL_NUMBER),
+      m_nrpnNumberLSB(NULL_NUMBER),
+      m_nrpnValueMSB(-1),
+      m_controllerToParameter(),
+      m_parameters(),
+      m_parameterSnapshots(),
+      m_snapshotVersion(0),
+      m_presetBank(),
+      m_presetWriter(),
       m_readyToSavePreset(false)
 {
     initControllableParameters();
     initPresets();
+    publishParameterSnapshot();
 }
 
-juce::MidiBuffer MidiBroker::getNoteMidiBuffer() noexcept
+void MidiBroker::popNoteMidiBuffer(juce::MidiBuffer& destBuffer, double blockStartTime,
+        double sampleRate, int numSamples) noexcept
 {
-    // We swap the buffers to make sure we don't block the other thread
-    // on the spinlock for too long
-    // It might be interesting to go for a lock-free FIFO implementation to avoid
-    // introducing some latency to the notes sometimes
-    auto newBuffer = juce::MidiBuffer();
+    jassert(numSamples > 0);
+    destBuffer.clear();
 
+    auto lastSample = double(numSamples - 1);
+    auto addEvent = [&] (const NoteEvent& event)
     {
-        auto tryLock = juce::SpinLock::ScopedTryLockType(m_spinLock);
-        if (tryLock.isLocked())
-        {
-            newBuffer.swapWith(m_midiBuffer);
-        }
+        auto position = (event.m_timestamp - blockStartTime) * sampleRate;
+        destBuffer.addEvent(event.m_data, 3, int(juce::jlimit(0., lastSample, position)));
+    };
+
+    int start1, size1, start2, size2;
+    m_noteFifo.prepareToRead(m_noteFifo.getNumReady(), start1, size1, start2, size2);
+
+    for (auto i = start1; i < start1 + size1; ++i)
+    {
+        addEvent(m_noteEvents[size_t(i)]);
     }
 
-    return newBuffer;
+    for (auto i = start2; i < start2 + size2; ++i)
+    {
+        addEvent(m_noteEvents[size_t(i)]);
+    }
+
+    m_noteFifo.finishedRead(size1 + size2);
+}
+
+const ParameterSnapshot& MidiBroker::readParameterSnapshot() noexcept
+{
+    return m_parameterSnapshots.read();
 }
 
 std::weak_ptr<ParameterMap> MidiBroker::getIdToParameterMap()
@@ -51,6 +110,12 @@ std::weak_ptr<ParameterMap> MidiBroker::getIdToParameterMap()
     return m_idToParameterMap;
 }
 
+void MidiBroker::setAbsoluteControls(bool absoluteControls)
+{
+    m_absoluteControls = absoluteControls;
+    m_controllerMSB.fill(0);
+}
+
 //==============================================================================
 void MidiBroker::handleIncomingMidiMessage(juce::MidiInput* source, const juce::MidiMessage& msg)
 {
@@ -83,164 +148,90 @@ void MidiBroker::initControllableParameters()
 {
     // We create and assign parameters to midi control signals
     m_idToParameterMap = std::make_shared<ParameterMap>();
-    auto settingsMap = parameters::Parameter::loadParameters(
-            m_globalChannel, m_savePatchCC);
+    m_controllerToParameter.fill(NO_PARAMETER);
+    auto configuration = parameters::Parameter::loadParameters();
+    auto& settingsMap = configuration.m_parameters;
+    m_globalChannel = configuration.m_globalChannel;
+    m_savePatchCC = configuration.m_savePatchCC;
+    m_numVoices = configuration.m_numVoices;
+    m_noiseSeed = configuration.m_noiseSeed;
+    m_absoluteControls = configuration.m_absoluteControls;
+
+    // The configuration can override the default resolution of each parameter
+    auto resolution = [] (const parameters::Parameter& settings, int defaultResolution)
+    {
+        return settings.m_resolution > 0 ? settings.m_resolution : defaultResolution;
+    };
     
-    // Attack
-    auto attackSettings = settingsMap[identifiers::controls::ATTACK];
-    auto attack = ControllableParameter(attackSettings.m_default,
-            attackSettings.m_min,
-            attackSettings.m_max,
-            ControllableParameter::ScaleType::logarithmic);
-    m_midiCCToParameterMap[attackSettings.m_cc] = attack;
-    (*m_idToParameterMap)[identifiers::controls::ATTACK] = attack;
-
-    // Decay
-    auto decaySettings = settingsMap[identifiers::controls::DECAY];
-    auto decay = ControllableParameter(decaySettings.m_default,
-            decaySettings.m_min,
-            decaySettings.m_max,
-            ControllableParameter::ScaleType::logarithmic);
-    m_midiCCToParameterMap[decaySettings.m_cc] = decay;
-    (*m_idToParameterMap)[identifiers::controls::DECAY] = decay;
-
-    // Sustain
-    auto sustainSettings = settingsMap[identifiers::controls::SUSTAIN];
-    auto sustain = ControllableParameter(sustainSettings.m_default,
-            sustainSettings.m_min,
-            sustainSettings.m_max);
-    m_midiCCToParameterMap[sustainSettings.m_cc] = sustain;
-    (*m_idToParameterMap)[identifiers::controls::SUSTAIN] = sustain;
-
-    // Release
-    auto releaseSettings = settingsMap[identifiers::controls::RELEASE];
-    auto release = ControllableParameter(releaseSettings.m_default,
-            releaseSettings.m_min,
-            releaseSettings.m_max,
-            ControllableParameter::ScaleType::logarithmic);
-    m_midiCCToParameterMap[releaseSettings.m_cc] = release;
-    (*m_idToParameterMap)[identifiers::controls::RELEASE] = release;
-
-    // Waveform ratio
-    auto waveformSettings = settingsMap[identifiers::controls::WAVEFORM_RATIO];
-    auto waveformRatio = ControllableParameter(
-            waveformSettings.m_default,
-            waveformSettings.m_min,
-            waveformSettings.m_max);
-    m_midiCCToParameterMap[waveformSettings.m_cc] = waveformRatio;
-    (*m_idToParameterMap)[identifiers::controls::WAVEFORM_RATIO] = waveformRatio;
-
-    // Glide
-    auto glideSettings = settingsMap[identifiers::controls::GLIDE];
-    auto glide = ControllableParameter(glideSettings.m_default,
-            glideSettings.m_min,
-            glideSettings.m_max,
-            ControllableParameter::ScaleType::linear,
-            256);
-    m_midiCCToParameterMap[glideSettings.m_cc] = glide;
-    (*m_idToParameterMap)[identifiers::controls::GLIDE] = glide;
-
-    // Filter Cutoff Frequency
-    auto cutoffSettings = settingsMap[identifiers::controls::CUTOFF];
-    auto cutoff = ControllableParameter(cutoffSettings.m_default,
-            cutoffSettings.m_min,
-            cutoffSettings.m_max,
-            ControllableParameter::ScaleType::logarithmic,
-            512);
-    m_midiCCToParameterMap[cutoffSettings.m_cc] = cutoff;
-    (*m_idToParameterMap)[identifiers::controls::CUTOFF] = cutoff;
-
-    // Filter Resonance
-    auto resonanceSettings = settingsMap[identifiers::controls::RESONANCE];
-    auto resonance = ControllableParameter(resonanceSettings.m_default,
-            resonanceSettings.m_min,
-            resonanceSettings.m_max);
-    m_midiCCToParameterMap[resonanceSettings.m_cc] = resonance;
-    (*m_idToParameterMap)[identifiers::controls::RESONANCE] = resonance;
-
-    // Filter Mix
-    auto filterSettings = settingsMap[identifiers::controls::FILTER_MIX];
-    auto filterMix = ControllableParameter(filterSettings.m_default,
-            filterSettings.m_min,
-            filterSettings.m_max);
-    m_midiCCToParameterMap[filterSettings.m_cc] = filterMix;
-    (*m_idToParameterMap)[identifiers::controls::FILTER_MIX] = filterMix;
-
-    // Envelope filter modulation
-    auto modSettings = settingsMap[identifiers::controls::ENV_MOD];
-    auto envMod = ControllableParameter(modSettings.m_default,
-            modSettings.m_min,
-            modSettings.m_max);
-    m_midiCCToParameterMap[modSettings.m_cc] = envMod;
-    (*m_idToParameterMap)[identifiers::controls::ENV_MOD] = envMod;
-
-    // Accent amount
-    auto accentConfig = settingsMap[identifiers::controls::ACCENT];
-    auto accent = ControllableParameter(accentConfig.m_default,
-            accentConfig.m_min,
-            accentConfig.m_max);
-    m_midiCCToParameterMap[accentConfig.m_cc] = accent;
-    (*m_idToParameterMap)[identifiers::controls::ACCENT] = accent;
-
-    // Accent decay
-    auto accentDecConfig = settingsMap[identifiers::controls::ACCENT_DECAY];
-    auto accentDec = ControllableParameter(accentDecConfig.m_default,
-            accentDecConfig.m_min,
-            accentDecConfig.m_max,
-            ControllableParameter::ScaleType::logarithmic);
-    m_midiCCToParameterMap[accentDecConfig.m_cc] = accentDec;
-    (*m_idToParameterMap)[identifiers::controls::ACCENT_DECAY] = accentDec;
+    // Every parameter of the list, with its scale and its default resolution
+    #define RACIDERRY_REGISTER_PARAMETER(name, scale, defaultResolution)                \
+    {                                                                                   \
+        const auto& settings = settingsMap[identifiers::controls::name];               \
+        registerParameter(ParameterSnapshot::name, settings.m_cc,                      \
+                ControllableParameter(settings.m_default, settings.m_min, settings.m_max, \
+                        ControllableParameter::ScaleType::scale,                       \
+                        resolution(settings, defaultResolution)));                     \
+    }
+    RACIDERRY_CONTROLS(RACIDERRY_REGISTER_PARAMETER)
+    #undef RACIDERRY_REGISTER_PARAMETER
+}
+
+void MidiBroker::registerParameter(ParameterSnapshot::Index index, int controllerNumber,
+        const ControllableParameter& parameter)
+{
+    jassert(controllerNumber >= 0 && controllerNumber < NUM_CONTROLLERS);
+    jassert(! m_parameters[size_t(index)].isValid());
+
+    m_parameters[size_t(index)] = parameter;
+    (*m_idToParameterMap)[ParameterSnapshot::getIdentifier(index)] = parameter;
+
+    if (controllerNumber >= 0 && controllerNumber < NUM_CONTROLLERS)
+    {
+        // Two parameters on the same controller is a configuration error
+        jassert(m_controllerToParameter[size_t(controllerNumber)] == NO_PARAMETER);
+        m_controllerToParameter[size_t(controllerNumber)] = juce::int8(index);
+    }
 }
 
 void MidiBroker::initPresets()
 {
-    auto presetFile = juce::File::getCurrentWorkingDirectory().getChildFile(parameters::files::PRESETS_FILE);
-    
-    if (presetFile.existsAsFile())
+    auto directory = juce::File::getCurrentWorkingDirectory();
+    auto bankFile = directory.getChildFile(parameters::files::PRESET_BANK_FILE);
+    m_presetWriter = std::make_unique<PresetWriter>(bankFile);
+
+    if (bankFile.existsAsFile() && m_presetBank.loadFromFile(bankFile))
     {
-        m_presets = juce::XmlDocument::parse(presetFile);
+        return;
     }
 
-    if (! presetFile.existsAsFile() || m_presets == nullptr)
+    // Convert the presets of the previous versions
+    auto legacyFile = directory.getChildFile(parameters::files::LEGACY_PRESETS_FILE);
+
+    if (legacyFile.existsAsFile() && m_presetBank.importLegacyXml(legacyFile, m_parameters))
     {
-        // If we cannot load a valid preset xml, we create a new one
-        DBG("No valid XML preset file found");
-        m_presets = std::make_unique<juce::XmlElement>(identifiers::miscellaneous::PRESETS);
-    }  
+        DBG("Legacy XML presets imported");
+        serializePresets();
+        return;
+    }
+
+    // If we cannot load a valid preset bank, we start with an empty one
+    DBG("No valid preset bank found");
 }
 
 void MidiBroker::serializePresets()
 {
-    jassert(m_presets != nullptr);
-    // DBG(m_presets->toString());
-    auto presetFile = juce::File::getCurrentWorkingDirectory().getChildFile(parameters::files::PRESETS_FILE);
-    auto success = m_presets->writeTo(presetFile);
-
-    if (! success)
-    {
-        DBG("Could not save presets to preset file");
-    }
+    // The midi thread never waits for the storage
+    jassert(m_presetWriter != nullptr);
+    m_presetWriter->requestWrite(m_presetBank);
 }
 
 void MidiBroker::loadPreset(int presetId)
 {
-    jassert(m_presets != nullptr);
-    
-    auto* preset = m_presets->getChildByName(presetPrefix + juce::String(presetId));
-
-    if (preset != nullptr)
+    // Every parameter is set before a single snapshot is published, the
+    // audio thread switches to the whole preset at once
+    if (m_presetBank.applyPreset(presetId, m_parameters))
     {
-        for (auto it = m_idToParameterMap->begin(); it != m_idToParameterMap->end(); ++it)
-        {
-            const auto& parameterId = it->first;
-            auto& parameter = it->second;
-
-            if (preset->hasAttribute(parameterId))
-            {
-                auto presetValue = preset->getIntAttribute(parameterId);
-                parameter.setDiscretValue(presetValue);
-            }
-        }
+        publishParameterSnapshot();
 
         #ifndef TESTING
         // This is goind to spam your test output
@@ -259,44 +250,36 @@ void MidiBroker::loadPreset(int presetId)
 
 void MidiBroker::saveToPreset(int presetId)
 {
-    jassert(m_presets != nullptr);
-    auto* newPresetXml = m_presets->createNewChildElement(presetPrefix + juce::String(presetId));
-
-    for (auto it = m_idToParameterMap->begin(); it != m_idToParameterMap->end(); ++it)
-    {
-        const auto& parameterId = it->first;
-        const auto& parameter = it->second;
-
-        newPresetXml->setAttribute(parameterId, parameter.getCurrentDiscretValue());
-    }
-
+    m_presetBank.storePreset(presetId, m_parameters);
     serializePresets();
 }
 
 void MidiBroker::handleNoteMessage(const juce::MidiMessage& msg)
 {
-    auto tryLock = juce::SpinLock::ScopedTryLockType(m_spinLock);
+    jassert(msg.getRawDataSize() == 3);
 
-    if (tryLock.isLocked())
-    {
-        m_midiBuffer.addEvent(msg, 0);
-        
-        for (auto msgIt = m_fallbackMidiBuffer.begin(); msgIt != m_fallbackMidiBuffer.end(); msgIt++)
-        {
-            m_midiBuffer.addEvent((*msgIt).getMessage(), 0);
-        }
-        
-        m_fallbackMidiBuffer.clear();
-    }
-    else
+    int start1, size1, start2, size2;
+    m_noteFifo.prepareToWrite(1, start1, size1, start2, size2);
+
+    if (size1 + size2 == 0)
     {
-        m_fallbackMidiBuffer.addEvent(msg, 0);
+        // The audio thread is not consuming the notes, there is nothing
+        // better to do than dropping it
+        DBG("Note fifo is full, dropping note message");
+        return;
     }
+
+    auto& event = m_noteEvents[size_t(size1 > 0 ? start1 : start2)];
+    event.m_timestamp = msg.getTimeStamp();
+    std::memcpy(event.m_data, msg.getRawData(), sizeof(event.m_data));
+
+    m_noteFifo.finishedWrite(1);
 }
 
 void MidiBroker::handleControllerMessage(const juce::MidiMessage& msg)
 {
     auto controllerNumber = msg.getControllerNumber();
+    auto controllerValue = msg.getControllerValue();
 
     if (msg.isControllerOfType(m_savePatchCC))
     {
@@ -305,27 +288,145 @@ void MidiBroker::handleControllerMessage(const juce::MidiMessage& msg)
         return;
     }
 
-    if (m_midiCCToParameterMap.count(controllerNumber) == 1)
+    auto parameterIndex = m_controllerToParameter[size_t(controllerNumber)];
+
+    if (parameterIndex != NO_PARAMETER)
     {
         // If this controller is assigned
+        auto& parameter = m_parameters[size_t(parameterIndex)];
 
-        // We use relative control values :
-        // 64 : no movement
-        // 58 -> 63 : negative movement, 58 the faster
-        // 65 -> 70 : positive movement, 65 the faster
-        auto controlDelta = msg.getControllerValue() - 64;
+        if (! m_absoluteControls)
+        {
+            // We use relative control values :
+            // 64 : no movement
+            // 58 -> 63 : negative movement, 58 the faster
+            // 65 -> 70 : positive movement, 65 the faster
+            auto controlDelta = controllerValue - 64;
+
+            if (controlDelta < -10 || controlDelta > 10)
+            {
+                DBG("Invalid midi control input detected");
+                return;
+            }
 
-        if (controlDelta < -10 || controlDelta > 10)
+            parameter.updateCurrentDiscretValue(controlDelta);
+        }
+        else if (controllerNumber < NUM_14BIT_CONTROLLERS)
         {
-            DBG("Invalid midi control input detected");
-            return;
+            // MSB of a 14-bit controller, the LSB may follow
+            m_controllerMSB[controllerNumber] = controllerValue;
+            parameter.setRatio(get14BitRatio(controllerValue));
+        }
+        else
+        {
+            parameter.setRatio(float(controllerValue) / 127.f);
         }
 
-        m_midiCCToParameterMap[controllerNumber].updateCurrentDiscretValue(controlDelta);
+        publishParameterSnapshot();
 
         // If you want to implement Midi return to your controller, this should
         // probably be the place
     }
+    else if (m_absoluteControls
+            && controllerNumber >= LSB_CONTROLLER_OFFSET
+            && controllerNumber < LSB_CONTROLLER_OFFSET + NUM_14BIT_CONTROLLERS
+            && m_controllerToParameter[size_t(controllerNumber - LSB_CONTROLLER_OFFSET)] != NO_PARAMETER)
+    {
+        // LSB of a 14-bit controller, combined with the last MSB received
+        auto msbNumber = controllerNumber - LSB_CONTROLLER_OFFSET;
+        m_parameters[size_t(m_controllerToParameter[size_t(msbNumber)])].setRatio(
+                get14BitRatio(m_controllerMSB[msbNumber], controllerValue));
+        publishParameterSnapshot();
+    }
+    else
+    {
+        handleNrpnMessage(controllerNumber, controllerValue);
+    }
+}
+
+void MidiBroker::handleNrpnMessage(int controllerNumber, int controllerValue)
+{
+    switch (controllerNumber)
+    {
+        case NRPN_MSB:
+            m_nrpnNumberMSB = controllerValue;
+            m_nrpnValueMSB = -1;
+            return;
+
+        case NRPN_LSB:
+            m_nrpnNumberLSB = controllerValue;
+            m_nrpnValueMSB = -1;
+            return;
+
+        case RPN_MSB:
+        case RPN_LSB:
+            // The RPN are not supported, but they deselect the NRPN
+            m_nrpnNumberMSB = NULL_NUMBER;
+            m_nrpnNumberLSB = NULL_NUMBER;
+            m_nrpnValueMSB = -1;
+            return;
+
+        default:
+            break;
+    }
+
+    auto* parameter = getNrpnParameter();
+
+    if (parameter == nullptr)
+    {
+        return;
+    }
+
+    switch (controllerNumber)
+    {
+        case DATA_ENTRY_MSB:
+            m_nrpnValueMSB = controllerValue;
+            parameter->setRatio(get14BitRatio(controllerValue));
+            break;
+
+        case DATA_ENTRY_LSB:
+            // A LSB without its MSB has no meaning
+            if (m_nrpnValueMSB < 0) { return; }
+            parameter->setRatio(get14BitRatio(m_nrpnValueMSB, controllerValue));
+            break;
+
+        case DATA_INCREMENT:
+            parameter->updateCurrentDiscretValue(1);
+            break;
+
+        case DATA_DECREMENT:
+            parameter->updateCurrentDiscretValue(-1);
+            break;
+
+        default:
+            return;
+    }
+
+    publishParameterSnapshot();
+}
+
+ControllableParameter* MidiBroker::getNrpnParameter()
+{
+    // The NRPN number of a parameter is its CC number
+    if (m_nrpnNumberMSB != 0)
+    {
+        return nullptr;
+    }
+
+    auto parameterIndex = m_controllerToParameter[size_t(m_nrpnNumberLSB)];
+
+    if (parameterIndex == NO_PARAMETER)
+    {
+        return nullptr;
+    }
+
+    return &m_parameters[size_t(parameterIndex)];
+}
+
+void MidiBroker::publishParameterSnapshot()
+{
+    m_parameterSnapshots.write(ParameterSnapshot::fromRegistry(
+            m_parameters, ++m_snapshotVersion));
 }
 
 }//namespace control
\ No newline at end of file
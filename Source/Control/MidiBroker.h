@@ -10,8 +10,14 @@
 
 #pragma once
 
+#include <array>
+
 #include <JuceHeader.h>
 #include "Control/ControllableParameter.h"
+#include "Control/ParameterSnapshot.h"
+#include "Control/PresetBank.h"
+#include "Control/PresetWriter.h"
+#include "Utils/TripleBuffer.h"
 
 namespace control
 {
@@ -19,6 +25,18 @@ namespace control
 /**
  * @class control::MidiBroker
  * @brief Performs the translation btw midi protocol and internal logic
+ * 
+ * The controllers assigned to a parameter use relative values by default. In
+ * absolute mode a controller sets the parameter position in its range, and the
+ * controllers 0 to 31 are read as the MSB of a 14-bit pair, with the
+ * controller 32 higher as their LSB.
+ * 
+ * Whatever the mode, the parameters can also be set through NRPN messages
+ * with a 14-bit value. The NRPN number of a parameter is its CC number.
+ * 
+ * The parameters are stored in a dense ParameterRegistry, and each controller
+ * number is dispatched to its parameter through a flat table, without any
+ * lookup in a map.
  */
 class MidiBroker : public juce::MidiInputCallback
 {
@@ -27,17 +45,64 @@ public:
     ~MidiBroker() {}
     
     /**
-     * @brief Get the next note buffer
+     * @brief Size of the note fifo, it can hold NOTE_FIFO_SIZE - 1 messages
+     */
+    static constexpr int NOTE_FIFO_SIZE = 1024;
+    /**
+     * @brief Number of midi controllers, the size of the dispatch table
+     */
+    static constexpr int NUM_CONTROLLERS = 128;
+
+    /**
+     * @brief Move every note message received since the last call into
+     * the given buffer, at the sample position matching their timestamp
+     * 
+     * A message is placed at (timestamp - blockStartTime) * sampleRate. 
+     * Messages older than blockStartTime are placed at the beginning of the
+     * block, and messages newer than the end of the block at its end.
+     * 
+     * @param destBuffer     The buffer to fill, cleared first. It should be 
+     * preallocated with ensureSize() to avoid any allocation
+     * @param blockStartTime The time matching the first sample of the block,
+     * in seconds, in the same clock than the midi messages timestamps
+     * @param sampleRate     The current sample rate
+     * @param numSamples     The number of samples of the block
+     * @note Lock-free and wait-free, the midi thread must be the only producer
+     * and the audio thread the only consumer
+     */
+    void popNoteMidiBuffer(juce::MidiBuffer& destBuffer, double blockStartTime,
+            double sampleRate, int numSamples) noexcept;
+
+    /**
+     * @brief Get the latest snapshot of the parameters values
+     * 
+     * A new snapshot is published each time a parameter is changed by a
+     * controller or a preset.
      * 
-     * @return const juce::MidiBuffer& A midi buffer containing every note 
-     * note message received since the last call
-     * @note Lock-free & thread safe, might return an empty buffer if the 
-     * main buffer is locked due to an incoming message
+     * @return The snapshot, which stays unchanged until the next call
+     * @note Wait-free, the audio thread must be the only caller
      */
-    juce::MidiBuffer getNoteMidiBuffer() noexcept;
+    const ParameterSnapshot& readParameterSnapshot() noexcept;
 
     std::weak_ptr<ParameterMap> getIdToParameterMap();
     int getMidiChannel() const { return m_globalChannel; };
+    /**
+     * @brief The number of voices of the synth, 1 for the mono mode
+     */
+    int getNumVoices() const { return m_numVoices; };
+    /**
+     * @brief The seed of the engine noise, 0 for a random one
+     */
+    juce::int64 getNoiseSeed() const { return m_noiseSeed; };
+    /**
+     * @brief Test if the controllers use absolute values, or relative ones
+     */
+    bool hasAbsoluteControls() const { return m_absoluteControls; };
+    /**
+     * @brief Switch btw relative and absolute controller values, the default
+     * one is read from the configuration
+     */
+    void setAbsoluteControls(bool absoluteControls);
 
 //==============================================================================
     /**
@@ -50,28 +115,57 @@ public:
 
 private:
     void initControllableParameters();
+    void registerParameter(ParameterSnapshot::Index index, int controllerNumber,
+            const ControllableParameter& parameter);
     void initPresets();
     void serializePresets();
     void loadPreset(int presetId);
     void saveToPreset(int presetId);
     void handleNoteMessage(const juce::MidiMessage& msg);
     void handleControllerMessage(const juce::MidiMessage& msg);
+    void handleNrpnMessage(int controllerNumber, int controllerValue);
+    ControllableParameter* getNrpnParameter();
+    void publishParameterSnapshot();
 
 //==============================================================================
 
+    /**
+     * @brief A note message waiting in the fifo
+     */
+    struct NoteEvent
+    {
+        double                              m_timestamp;
+        juce::uint8                         m_data[3];
+    };
+
     // Midi notes handling
-    juce::SpinLock                          m_spinLock;
-    juce::MidiBuffer                        m_midiBuffer;
-    juce::MidiBuffer                        m_fallbackMidiBuffer;
+    juce::AbstractFifo                      m_noteFifo;
+    std::array<NoteEvent, NOTE_FIFO_SIZE>   m_noteEvents;
     int                                     m_globalChannel;
     int                                     m_savePatchCC;
+    int                                     m_numVoices;
+    juce::int64                             m_noiseSeed;
+
+    // High resolution controls
+    static constexpr int NUM_14BIT_CONTROLLERS = 32;
+    bool                                    m_absoluteControls;
+    std::array<int, NUM_14BIT_CONTROLLERS>  m_controllerMSB;
+    int                                     m_nrpnNumberMSB;
+    int                                     m_nrpnNumberLSB;
+    int                                     m_nrpnValueMSB;
 
-    // Parameters mapping
-    std::map<int, ControllableParameter>    m_midiCCToParameterMap;
+    // Parameters mapping, the dispatch table holds the index of the parameter
+    // assigned to each controller, or NO_PARAMETER
+    static constexpr juce::int8 NO_PARAMETER = -1;
+    std::array<juce::int8, NUM_CONTROLLERS> m_controllerToParameter;
+    ParameterRegistry                       m_parameters;
     std::shared_ptr<ParameterMap>           m_idToParameterMap;
+    utils::TripleBuffer<ParameterSnapshot>  m_parameterSnapshots;
+    juce::uint32                            m_snapshotVersion;
 
-    // Presets mapping
-    std::unique_ptr<juce::XmlElement>       m_presets;
+    // Presets, written by a background thread
+    PresetBank                              m_presetBank;
+    std::unique_ptr<PresetWriter>           m_presetWriter;
     bool                                    m_readyToSavePreset;
 };
 
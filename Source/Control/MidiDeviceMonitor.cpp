@@ -10,21 +10,182 @@
 
 #include "MidiDeviceMonitor.h"
 
+#include <alsa/asoundlib.h>
+#include <poll.h>
+#include <unistd.h>
+
+// Only used when the sequencer is not available
 constexpr auto CHECK_INTERVAL_MS = 500;
+constexpr auto STOP_TIMEOUT_MS = 1000;
 
 namespace control
 {
 
 MidiDeviceMonitor::MidiDeviceMonitor(juce::AudioDeviceManager& deviceManager)
-    : r_deviceManager(deviceManager)
+    : juce::Thread("Midi device monitor"),
+      r_deviceManager(deviceManager),
+      m_sequencer(nullptr),
+      m_clientId(-1),
+      m_wakeUpPipe{-1, -1}
+{
+    updateDevices();
+
+    if (openSequencer())
+    {
+        startThread();
+    }
+    else
+    {
+        DBG("ALSA sequencer not available, polling the MIDI devices");
+        startTimer(CHECK_INTERVAL_MS);
+    }
+}
+
+MidiDeviceMonitor::~MidiDeviceMonitor()
 {
-    startTimer(CHECK_INTERVAL_MS);
+    stopTimer();
+
+    if (isThreadRunning())
+    {
+        signalThreadShouldExit();
+        auto byte = char(0);
+        juce::ignoreUnused(::write(m_wakeUpPipe[1], &byte, 1));
+        stopThread(STOP_TIMEOUT_MS);
+    }
+
+    cancelPendingUpdate();
+    closeSequencer();
+}
+
+//==============================================================================
+void MidiDeviceMonitor::run()
+{
+    auto numDescriptors = snd_seq_poll_descriptors_count(m_sequencer, POLLIN);
+    auto descriptors = std::vector<pollfd>(size_t(numDescriptors + 1));
+    snd_seq_poll_descriptors(m_sequencer, descriptors.data(), unsigned(numDescriptors), POLLIN);
+
+    auto& wakeUp = descriptors.back();
+    wakeUp.fd = m_wakeUpPipe[0];
+    wakeUp.events = POLLIN;
+
+    while (! threadShouldExit())
+    {
+        // Sleeps until an event is announced
+        if (::poll(descriptors.data(), descriptors.size(), -1) < 0)
+        {
+            if (errno == EINTR) { continue; }
+
+            DBG("Failed to poll the ALSA sequencer");
+            return;
+        }
+
+        if (wakeUp.revents != 0) { return; }
+
+        if (readAnnounceEvents())
+        {
+            // The devices are handled on the message thread
+            triggerAsyncUpdate();
+        }
+    }
+}
+
+void MidiDeviceMonitor::handleAsyncUpdate()
+{
+    updateDevices();
 }
 
 void MidiDeviceMonitor::timerCallback()
+{
+    updateDevices();
+}
+
+//==============================================================================
+bool MidiDeviceMonitor::openSequencer()
+{
+    if (snd_seq_open(&m_sequencer, "default", SND_SEQ_OPEN_INPUT, SND_SEQ_NONBLOCK) < 0)
+    {
+        m_sequencer = nullptr;
+        return false;
+    }
+
+    snd_seq_set_client_name(m_sequencer, "raciderry monitor");
+    m_clientId = snd_seq_client_id(m_sequencer);
+
+    auto port = snd_seq_create_simple_port(m_sequencer, "announce",
+            SND_SEQ_PORT_CAP_WRITE | SND_SEQ_PORT_CAP_NO_EXPORT,
+            SND_SEQ_PORT_TYPE_APPLICATION);
+
+    if (port < 0
+            || snd_seq_connect_from(m_sequencer, port, SND_SEQ_CLIENT_SYSTEM,
+                    SND_SEQ_PORT_SYSTEM_ANNOUNCE) < 0
+            || ::pipe(m_wakeUpPipe) < 0)
+    {
+        closeSequencer();
+        return false;
+    }
+
+    return true;
+}
+
+void MidiDeviceMonitor::closeSequencer()
+{
+    if (m_sequencer != nullptr)
+    {
+        snd_seq_close(m_sequencer);
+        m_sequencer = nullptr;
+    }
+
+    for (auto& fd : m_wakeUpPipe)
+    {
+        if (fd >= 0)
+        {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+}
+
+bool MidiDeviceMonitor::readAnnounceEvents()
+{
+    auto devicesChanged = false;
+    snd_seq_event_t* event = nullptr;
+
+    while (true)
+    {
+        auto result = snd_seq_event_input(m_sequencer, &event);
+
+        if (result == -ENOSPC)
+        {
+            // Some events were lost, they may have been announces
+            devicesChanged = true;
+            continue;
+        }
+
+        if (result < 0) { break; }
+
+        switch (event->type)
+        {
+            case SND_SEQ_EVENT_CLIENT_START:
+            case SND_SEQ_EVENT_CLIENT_EXIT:
+            case SND_SEQ_EVENT_PORT_START:
+            case SND_SEQ_EVENT_PORT_EXIT:
+            case SND_SEQ_EVENT_PORT_CHANGE:
+                // Our own port does not matter
+                devicesChanged |= event->data.addr.client != m_clientId;
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    return devicesChanged;
+}
+
+void MidiDeviceMonitor::updateDevices()
 {
     auto midiDeviceInfo = juce::MidiInput::getAvailableDevices();
-    
+
     std::unordered_set<juce::String> available_devices;
 
     for (auto& device : midiDeviceInfo)
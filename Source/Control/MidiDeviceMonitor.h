@@ -12,35 +12,70 @@
 
 #include <JuceHeader.h>
 
+// From alsa/asoundlib.h, to keep it out of the header
+typedef struct _snd_seq snd_seq_t;
+
 namespace control
 {
 
 /**
  * @class control::MidiDeviceMonitor
- * @brief A tiny utility class which peridically watch for available MIDI 
- * connections and automatically enable MIDI routing to the given device
- * 
+ * @brief A tiny utility class which watch for available MIDI connections and
+ * automatically enable MIDI routing to the given device
+ *
+ * The monitor listens to the announce port of the ALSA sequencer from a
+ * background thread, which sleeps until a client or a port appears or
+ * disappears. The devices are then updated on the message thread, so a new
+ * controller is connected within milliseconds and nothing runs while idle.
+ *
+ * If the sequencer cannot be opened, the monitor falls back to checking the
+ * available devices periodically.
  */
-class MidiDeviceMonitor : public juce::Timer
+class MidiDeviceMonitor : private juce::Thread,
+                          private juce::AsyncUpdater,
+                          private juce::Timer
 {
 public:
     /**
-     * @brief Construct a new Midi Device Monitor object
-     * 
+     * @brief Construct a new Midi Device Monitor object, the devices already
+     * available are connected right away
+     *
      * @param deviceManager The device manager to link the MIDI device to
      */
     MidiDeviceMonitor(juce::AudioDeviceManager& deviceManager);
+    ~MidiDeviceMonitor() override;
 
+private:
     /**
-     * @name juce::Timer overrides.
+     * @name juce::Thread, juce::AsyncUpdater and juce::Timer overrides.
      */
     ///@{
+    void run() override;
+    void handleAsyncUpdate() override;
     void timerCallback() override;
     ///@}
 
-private:
+    bool openSequencer();
+    void closeSequencer();
+    /**
+     * @brief Read all the pending sequencer events
+     * @return true if one of them announces a change of the devices
+     */
+    bool readAnnounceEvents();
+    /**
+     * @brief Connect the new devices and disconnect the removed ones
+     */
+    void updateDevices();
+
+//==============================================================================
     juce::AudioDeviceManager&           r_deviceManager;
     std::unordered_set<juce::String>    m_enabledDevices;
+
+    // Sequencer client listening to the announce port
+    snd_seq_t*                          m_sequencer;
+    int                                 m_clientId;
+    // Written to wake up the thread when it must stop
+    int                                 m_wakeUpPipe[2];
 };
 
 } // namespace control
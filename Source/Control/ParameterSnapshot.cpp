@@ -0,0 +1,68 @@
+/*
+  ==============================================================================
+
+    ParameterSnapshot.cpp
+    Created: 17 Oct 2026 9:20:41pm
+    Author:  maxime
+
+  ==============================================================================
+*/
+
+#include "ParameterSnapshot.h"
+
+namespace control
+{
+
+const juce::Identifier& ParameterSnapshot::getIdentifier(Index index) noexcept
+{
+    static const juce::Identifier* const identifiersByIndex[NUM_PARAMETERS] = {
+        #define RACIDERRY_IDENTIFIER_ADDRESS(name, scale, resolution) &identifiers::controls::name,
+        RACIDERRY_CONTROLS(RACIDERRY_IDENTIFIER_ADDRESS)
+        #undef RACIDERRY_IDENTIFIER_ADDRESS
+    };
+
+    jassert(index >= 0 && index < NUM_PARAMETERS);
+    return *identifiersByIndex[index];
+}
+
+ParameterSnapshot ParameterSnapshot::fromParameterMap(const ParameterMap& parameterMap,
+        juce::uint32 version)
+{
+    auto registry = ParameterRegistry();
+
+    for (auto i = 0; i < NUM_PARAMETERS; ++i)
+    {
+        auto it = parameterMap.find(getIdentifier(Index(i)));
+
+        if (it != parameterMap.end())
+        {
+            registry[size_t(i)] = it->second;
+        }
+    }
+
+    return fromRegistry(registry, version);
+}
+
+ParameterSnapshot ParameterSnapshot::fromRegistry(const ParameterRegistry& registry,
+        juce::uint32 version)
+{
+    auto snapshot = ParameterSnapshot();
+    snapshot.m_values.fill(0.f);
+    snapshot.m_ratios.fill(0.f);
+    snapshot.m_version = version;
+
+    for (auto i = 0; i < NUM_PARAMETERS; ++i)
+    {
+        const auto& parameter = registry[size_t(i)];
+
+        if (parameter.isValid())
+        {
+            snapshot.m_values[size_t(i)] = parameter.getCurrentValue();
+            snapshot.m_ratios[size_t(i)] = parameter.getUnscaledRatioForCurrentValue();
+        }
+    }
+
+    return snapshot;
+}
+
+} // namespace control
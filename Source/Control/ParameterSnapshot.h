@@ -0,0 +1,100 @@
+/*
+  ==============================================================================
+
+    ParameterSnapshot.h
+    Created: 17 Oct 2026 9:20:41pm
+    Author:  maxime
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <type_traits>
+
+#include <JuceHeader.h>
+
+#include "Control/ControllableParameter.h"
+#include "Utils/Identifiers.h"
+
+namespace control
+{
+
+/**
+ * @struct control::ParameterSnapshot
+ * @brief A flat copy of the current value of every controllable parameter
+ *
+ * The snapshot is built by the midi thread each time a parameter changes, and
+ * published to the audio thread which reads it once per callback. DSP modules
+ * then consume plain floats, without going through the ControllableParameter
+ * pimpl and its atomic.
+ *
+ * Both the value and the unscaled ratio (the position within the scaled range,
+ * see ControllableParameter::getUnscaledRatioForCurrentValue()) of each
+ * parameter are stored.
+ *
+ * The Index of the parameters is generated from the RACIDERRY_CONTROLS list,
+ * it is also the index of the parameters in a ParameterRegistry.
+ */
+struct alignas(64) ParameterSnapshot
+{
+    /**
+     * @brief Position of each controllable parameter in the snapshot
+     */
+    enum Index
+    {
+        #define RACIDERRY_DECLARE_INDEX(name, scale, resolution) name,
+        RACIDERRY_CONTROLS(RACIDERRY_DECLARE_INDEX)
+        #undef RACIDERRY_DECLARE_INDEX
+        NUM_PARAMETERS
+    };
+
+    float getValue(Index index) const noexcept { return m_values[size_t(index)]; }
+    float getRatio(Index index) const noexcept { return m_ratios[size_t(index)]; }
+
+    /**
+     * @brief Get the identifier of the parameter stored at the given index
+     */
+    static const juce::Identifier& getIdentifier(Index index) noexcept;
+
+    /**
+     * @brief Build a snapshot of the current values of the parameters
+     *
+     * The parameters missing from the map keep a value and a ratio of 0
+     *
+     * @param parameterMap The map to read the parameters from
+     * @param version      The version of the snapshot
+     */
+    static ParameterSnapshot fromParameterMap(const ParameterMap& parameterMap,
+            juce::uint32 version = 0);
+
+    /**
+     * @brief Build a snapshot of the current values of the parameters
+     *
+     * Same than fromParameterMap() without any lookup, the invalid parameters
+     * keep a value and a ratio of 0
+     *
+     * @param registry The parameters, at their index
+     * @param version  The version of the snapshot
+     */
+    static ParameterSnapshot fromRegistry(
+            const std::array<ControllableParameter, NUM_PARAMETERS>& registry,
+            juce::uint32 version = 0);
+
+//==============================================================================
+    std::array<float, NUM_PARAMETERS>       m_values;
+    std::array<float, NUM_PARAMETERS>       m_ratios;
+    // Incremented by the midi thread at each publication
+    juce::uint32                            m_version;
+};
+
+static_assert(std::is_trivially_copyable<ParameterSnapshot>::value,
+        "The snapshot is copied between threads as raw memory");
+
+/**
+ * @brief Every controllable parameter, at its ParameterSnapshot::Index
+ */
+using ParameterRegistry = std::array<ControllableParameter, ParameterSnapshot::NUM_PARAMETERS>;
+
+} // namespace control
@@ -0,0 +1,310 @@
+/*
+  ==============================================================================
+
+    PresetBank.cpp
+    Created: 17 Oct 2026 11:58:14pm
+    Author:  maxime
+
+  ==============================================================================
+*/
+
+#include "PresetBank.h"
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace control
+{
+
+namespace
+{
+
+constexpr char          BANK_MAGIC[4] = {'R', 'C', 'P', 'B'};
+constexpr juce::uint32  BANK_VERSION = 1;
+constexpr int           NAME_SIZE = 32;
+const auto              LEGACY_PRESET_PREFIX = juce::String("preset_");
+
+/**
+ * @brief The header of a bank file
+ */
+struct FileHeader
+{
+    char                    m_magic[4];
+    juce::uint32            m_version;
+    juce::uint32            m_numSlots;
+    juce::uint32            m_numParameters;
+    // The identifier of the parameter stored in each column, null terminated
+    char                    m_parameterNames[PresetBank::MAX_PARAMETERS][NAME_SIZE];
+};
+
+/**
+ * @brief A slot of a bank file
+ */
+struct FileRecord
+{
+    juce::uint32            m_used;
+    float                   m_ratios[PresetBank::MAX_PARAMETERS];
+};
+
+static_assert(std::is_trivially_copyable<FileHeader>::value
+        && std::is_trivially_copyable<FileRecord>::value,
+        "The bank file is read and written as raw memory");
+
+constexpr size_t BANK_FILE_SIZE = sizeof(FileHeader) + PresetBank::NUM_SLOTS * sizeof(FileRecord);
+
+/**
+ * @brief Flush a file or a directory to the storage, without it a power loss
+ * right after a rename can leave an empty bank
+ */
+bool syncToStorage(const juce::File& file)
+{
+    auto fd = ::open(file.getFullPathName().toRawUTF8(), O_RDONLY);
+
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    auto success = ::fsync(fd) == 0;
+    ::close(fd);
+    return success;
+}
+
+} // namespace
+
+//==============================================================================
+PresetBank::PresetBank()
+    : m_slots()
+{
+    clear();
+}
+
+bool PresetBank::hasPreset(int slot) const noexcept
+{
+    return slot >= 0 && slot < NUM_SLOTS && m_slots[size_t(slot)].m_used;
+}
+
+void PresetBank::storePreset(int slot, const ParameterRegistry& parameters) noexcept
+{
+    jassert(slot >= 0 && slot < NUM_SLOTS);
+    if (slot < 0 || slot >= NUM_SLOTS) { return; }
+
+    auto& preset = m_slots[size_t(slot)];
+    preset.m_used = true;
+
+    for (auto i = 0; i < ParameterSnapshot::NUM_PARAMETERS; ++i)
+    {
+        const auto& parameter = parameters[size_t(i)];
+        preset.m_ratios[size_t(i)] = parameter.isValid()
+                ? parameter.getUnscaledRatioForCurrentValue() : NO_VALUE;
+    }
+}
+
+bool PresetBank::applyPreset(int slot, ParameterRegistry& parameters) const noexcept
+{
+    if (! hasPreset(slot)) { return false; }
+
+    const auto& preset = m_slots[size_t(slot)];
+
+    for (auto i = 0; i < ParameterSnapshot::NUM_PARAMETERS; ++i)
+    {
+        auto& parameter = parameters[size_t(i)];
+        auto ratio = preset.m_ratios[size_t(i)];
+
+        if (parameter.isValid() && ratio >= 0.f)
+        {
+            parameter.setRatio(juce::jmin(ratio, 1.f));
+        }
+    }
+
+    return true;
+}
+
+void PresetBank::clear() noexcept
+{
+    for (auto& slot : m_slots)
+    {
+        slot.m_used = false;
+        slot.m_ratios.fill(NO_VALUE);
+    }
+}
+
+//==============================================================================
+bool PresetBank::loadFromFile(const juce::File& file)
+{
+    auto mappedFile = juce::MemoryMappedFile(file, juce::MemoryMappedFile::readOnly);
+    const auto* data = static_cast<const char*>(mappedFile.getData());
+
+    if (data == nullptr || mappedFile.getSize() < BANK_FILE_SIZE)
+    {
+        return false;
+    }
+
+    // The mapping has no alignment guarantee, the structures are copied
+    auto header = FileHeader();
+    std::memcpy(&header, data, sizeof(FileHeader));
+
+    if (std::memcmp(header.m_magic, BANK_MAGIC, sizeof(BANK_MAGIC)) != 0
+            || header.m_version != BANK_VERSION
+            || header.m_numSlots != NUM_SLOTS
+            || header.m_numParameters > MAX_PARAMETERS)
+    {
+        DBG("Invalid preset bank file");
+        return false;
+    }
+
+    // Find the parameter stored in each column
+    int columnToIndex[MAX_PARAMETERS];
+
+    for (auto column = 0; column < MAX_PARAMETERS; ++column)
+    {
+        columnToIndex[column] = -1;
+        if (column >= int(header.m_numParameters)) { continue; }
+
+        const auto* name = header.m_parameterNames[column];
+        auto nameLength = int(std::find(name, name + NAME_SIZE, '\0') - name);
+        auto identifier = juce::String::fromUTF8(name, nameLength);
+
+        for (auto i = 0; i < ParameterSnapshot::NUM_PARAMETERS; ++i)
+        {
+            if (ParameterSnapshot::getIdentifier(ParameterSnapshot::Index(i)) == identifier)
+            {
+                columnToIndex[column] = i;
+                break;
+            }
+        }
+    }
+
+    clear();
+    const auto* records = data + sizeof(FileHeader);
+
+    for (auto slot = 0; slot < NUM_SLOTS; ++slot)
+    {
+        auto record = FileRecord();
+        std::memcpy(&record, records + size_t(slot) * sizeof(FileRecord), sizeof(FileRecord));
+
+        auto& preset = m_slots[size_t(slot)];
+        preset.m_used = record.m_used != 0;
+
+        for (auto column = 0; column < MAX_PARAMETERS; ++column)
+        {
+            if (columnToIndex[column] >= 0)
+            {
+                preset.m_ratios[size_t(columnToIndex[column])] = record.m_ratios[column];
+            }
+        }
+    }
+
+    return true;
+}
+
+bool PresetBank::saveToFile(const juce::File& file) const
+{
+    auto bankData = juce::MemoryBlock(BANK_FILE_SIZE, true);
+    auto* data = static_cast<char*>(bankData.getData());
+
+    auto header = FileHeader();
+    std::memcpy(header.m_magic, BANK_MAGIC, sizeof(BANK_MAGIC));
+    header.m_version = BANK_VERSION;
+    header.m_numSlots = NUM_SLOTS;
+    header.m_numParameters = ParameterSnapshot::NUM_PARAMETERS;
+
+    for (auto i = 0; i < ParameterSnapshot::NUM_PARAMETERS; ++i)
+    {
+        ParameterSnapshot::getIdentifier(ParameterSnapshot::Index(i)).toString()
+                .copyToUTF8(header.m_parameterNames[i], NAME_SIZE);
+    }
+
+    std::memcpy(data, &header, sizeof(FileHeader));
+
+    for (auto slot = 0; slot < NUM_SLOTS; ++slot)
+    {
+        const auto& preset = m_slots[size_t(slot)];
+        auto record = FileRecord();
+        record.m_used = preset.m_used ? 1 : 0;
+        std::fill(std::begin(record.m_ratios), std::end(record.m_ratios), NO_VALUE);
+        std::copy(preset.m_ratios.begin(), preset.m_ratios.end(), record.m_ratios);
+
+        std::memcpy(data + sizeof(FileHeader) + size_t(slot) * sizeof(FileRecord),
+                &record, sizeof(FileRecord));
+    }
+
+    // The bank is only replaced once the new one is completely written, the
+    // rename is atomic
+    auto tempFile = juce::TemporaryFile(file);
+
+    {
+        auto stream = juce::FileOutputStream(tempFile.getFile());
+
+        if (! stream.openedOk() || ! stream.write(data, bankData.getSize()))
+        {
+            return false;
+        }
+
+        stream.flush();
+
+        if (stream.getStatus().failed())
+        {
+            return false;
+        }
+    }
+
+    // The content must be on the storage before the rename, and the rename
+    // itself is only durable once the directory is flushed
+    if (! syncToStorage(tempFile.getFile()) || ! tempFile.overwriteTargetFileWithTemporary())
+    {
+        return false;
+    }
+
+    return syncToStorage(file.getParentDirectory());
+}
+
+bool PresetBank::importLegacyXml(const juce::File& file, const ParameterRegistry& parameters)
+{
+    auto xml = juce::XmlDocument::parse(file);
+
+    if (xml == nullptr)
+    {
+        return false;
+    }
+
+    clear();
+
+    for (auto slot = 0; slot < NUM_SLOTS; ++slot)
+    {
+        // The last preset saved for a slot is the valid one
+        const juce::XmlElement* legacyPreset = nullptr;
+        auto name = LEGACY_PRESET_PREFIX + juce::String(slot);
+
+        for (auto* child : xml->getChildWithTagNameIterator(name))
+        {
+            legacyPreset = child;
+        }
+
+        if (legacyPreset == nullptr) { continue; }
+
+        auto& preset = m_slots[size_t(slot)];
+        preset.m_used = true;
+
+        for (auto i = 0; i < ParameterSnapshot::NUM_PARAMETERS; ++i)
+        {
+            const auto& identifier = ParameterSnapshot::getIdentifier(ParameterSnapshot::Index(i));
+            const auto& parameter = parameters[size_t(i)];
+
+            if (parameter.isValid() && legacyPreset->hasAttribute(identifier))
+            {
+                auto maxValue = float(parameter.getDiscretRange() - 1);
+                auto discretValue = float(legacyPreset->getIntAttribute(identifier));
+                preset.m_ratios[size_t(i)] = juce::jlimit(0.f, 1.f, discretValue / maxValue);
+            }
+        }
+    }
+
+    return true;
+}
+
+} // namespace control
@@ -0,0 +1,124 @@
+/*
+  ==============================================================================
+
+    PresetBank.h
+    Created: 17 Oct 2026 11:58:14pm
+    Author:  maxime
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <type_traits>
+
+#include <JuceHeader.h>
+
+#include "Control/ParameterSnapshot.h"
+
+namespace control
+{
+
+/**
+ * @class control::PresetBank
+ * @brief The NUM_SLOTS presets of the synth, one for each program change
+ *
+ * A preset stores the unscaled ratio of each parameter, so it does not depend
+ * on the resolution of the parameters. The whole bank is held in memory,
+ * storing or applying a preset never allocates nor parses anything.
+ *
+ * The bank file is a header followed by NUM_SLOTS fixed-size records, in the
+ * byte order of the machine. The header holds the names of the parameters
+ * stored in each column of the records, so parameters can be added or
+ * reordered without breaking the existing banks. It is read through a memory
+ * mapping, and written to a temporary file which then replaces the bank, so a
+ * crash never leaves a half written bank.
+ *
+ * The bank is trivially copyable, a copy can be handed to another thread.
+ */
+class PresetBank
+{
+public:
+    static constexpr int NUM_SLOTS = 128;
+    /**
+     * @brief Number of parameter columns of the records, the bank file can
+     * hold new parameters without changing its format
+     */
+    static constexpr int MAX_PARAMETERS = 32;
+
+    static_assert(ParameterSnapshot::NUM_PARAMETERS <= MAX_PARAMETERS,
+            "Too many parameters for the preset bank records");
+
+    PresetBank();
+
+//==============================================================================
+    /**
+     * @brief Test if a preset was stored in the given slot
+     */
+    bool hasPreset(int slot) const noexcept;
+
+    /**
+     * @brief Store the current values of the parameters in the given slot,
+     * the previous preset of the slot is replaced
+     */
+    void storePreset(int slot, const ParameterRegistry& parameters) noexcept;
+
+    /**
+     * @brief Set the parameters to the values of the preset of the given slot
+     *
+     * The parameters which are not stored in the preset keep their value
+     *
+     * @return false if the slot is empty
+     */
+    bool applyPreset(int slot, ParameterRegistry& parameters) const noexcept;
+
+    /**
+     * @brief Remove every preset
+     */
+    void clear() noexcept;
+
+//==============================================================================
+    /**
+     * @brief Replace the bank with the content of a bank file
+     *
+     * @return false if the file is missing or invalid, the bank is then left
+     * unchanged
+     */
+    bool loadFromFile(const juce::File& file);
+
+    /**
+     * @brief Write the bank to a file, through a temporary file flushed to the
+     * storage then renamed
+     * @note Slow and blocking, see control::PresetWriter
+     */
+    bool saveToFile(const juce::File& file) const;
+
+    /**
+     * @brief Replace the bank with the presets of a legacy xml preset file,
+     * which stores the discret value of each parameter
+     *
+     * @param file       The xml file
+     * @param parameters The parameters the discret values belong to
+     * @return false if the file could not be parsed
+     */
+    bool importLegacyXml(const juce::File& file, const ParameterRegistry& parameters);
+
+private:
+    // Ratio of a parameter which is not stored in a preset
+    static constexpr float NO_VALUE = -1.f;
+
+    struct Slot
+    {
+        bool                                                m_used;
+        std::array<float, ParameterSnapshot::NUM_PARAMETERS> m_ratios;
+    };
+
+//==============================================================================
+    std::array<Slot, NUM_SLOTS>             m_slots;
+};
+
+static_assert(std::is_trivially_copyable<PresetBank>::value,
+        "The bank is handed to the preset writer as raw memory");
+
+} // namespace control
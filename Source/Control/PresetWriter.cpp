@@ -0,0 +1,102 @@
+/*
+  ==============================================================================
+
+    PresetWriter.cpp
+    Created: 18 Oct 2026 1:04:47am
+    Author:  maxime
+
+  ==============================================================================
+*/
+
+#include "PresetWriter.h"
+
+namespace control
+{
+
+constexpr auto STOP_TIMEOUT_MS = 2000;
+
+PresetWriter::PresetWriter(const juce::File& bankFile)
+    : juce::Thread("Preset writer"),
+      m_bankFile(bankFile),
+      m_pendingBanks(),
+      m_writeRequested(),
+      m_bankWritten(),
+      m_requestedVersion(0),
+      m_writtenVersion(0),
+      m_numWrites(0)
+{
+    // The storage is slow, the writer does not need a high priority
+    startThread(2);
+}
+
+PresetWriter::~PresetWriter()
+{
+    signalThreadShouldExit();
+    m_writeRequested.signal();
+    stopThread(STOP_TIMEOUT_MS);
+}
+
+//==============================================================================
+void PresetWriter::requestWrite(const PresetBank& bank) noexcept
+{
+    m_pendingBanks.write(bank);
+    m_requestedVersion.fetch_add(1, std::memory_order_release);
+    m_writeRequested.signal();
+}
+
+bool PresetWriter::waitUntilWritten(int timeoutMs)
+{
+    auto deadline = juce::Time::getMillisecondCounter() + juce::uint32(timeoutMs);
+
+    while (m_writtenVersion.load() != m_requestedVersion.load())
+    {
+        auto remainingMs = -1;
+
+        if (timeoutMs >= 0)
+        {
+            auto now = juce::Time::getMillisecondCounter();
+            if (now >= deadline) { return false; }
+            remainingMs = int(deadline - now);
+        }
+
+        m_bankWritten.wait(remainingMs);
+    }
+
+    return true;
+}
+
+//==============================================================================
+void PresetWriter::run()
+{
+    while (! threadShouldExit())
+    {
+        m_writeRequested.wait(-1);
+        writePendingBank();
+    }
+
+    // Do not lose the last save
+    writePendingBank();
+}
+
+void PresetWriter::writePendingBank()
+{
+    // The bank read is at least as recent as this version
+    auto version = m_requestedVersion.load(std::memory_order_acquire);
+
+    if (m_pendingBanks.hasNewValue())
+    {
+        if (m_pendingBanks.read().saveToFile(m_bankFile))
+        {
+            m_numWrites.fetch_add(1);
+        }
+        else
+        {
+            DBG("Could not save presets to preset file");
+        }
+    }
+
+    m_writtenVersion.store(version);
+    m_bankWritten.signal();
+}
+
+} // namespace control
@@ -0,0 +1,75 @@
+/*
+  ==============================================================================
+
+    PresetWriter.h
+    Created: 18 Oct 2026 1:04:47am
+    Author:  maxime
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+
+#include <JuceHeader.h>
+
+#include "Control/PresetBank.h"
+#include "Utils/TripleBuffer.h"
+
+namespace control
+{
+
+/**
+ * @class control::PresetWriter
+ * @brief Writes the preset bank to its file from a background thread
+ *
+ * The midi thread hands a copy of the bank to the writer, which never waits
+ * for the storage : the SD card of the Pi can stall for tens of milliseconds.
+ * The copies are exchanged through a utils::TripleBuffer, so the writes
+ * requested while the writer is busy are coalesced, only the latest bank is
+ * written.
+ *
+ * The pending bank is written before the writer is destroyed.
+ */
+class PresetWriter : private juce::Thread
+{
+public:
+    explicit PresetWriter(const juce::File& bankFile);
+    ~PresetWriter() override;
+
+    /**
+     * @brief Ask for the bank to be written
+     * @note Never waits for the storage, the midi thread must be the only
+     * caller
+     */
+    void requestWrite(const PresetBank& bank) noexcept;
+
+    /**
+     * @brief Wait until every requested bank is written
+     *
+     * @param timeoutMs The maximum time to wait, -1 to wait forever
+     * @return false on timeout
+     */
+    bool waitUntilWritten(int timeoutMs = -1);
+
+    /**
+     * @brief The number of times the file was written
+     */
+    int getNumWrites() const noexcept { return m_numWrites.load(); }
+
+private:
+    void run() override;
+    void writePendingBank();
+
+//==============================================================================
+    juce::File                          m_bankFile;
+    utils::TripleBuffer<PresetBank>     m_pendingBanks;
+    juce::WaitableEvent                 m_writeRequested;
+    juce::WaitableEvent                 m_bankWritten;
+    std::atomic<juce::uint32>           m_requestedVersion;
+    std::atomic<juce::uint32>           m_writtenVersion;
+    std::atomic<int>                    m_numWrites;
+};
+
+} // namespace control
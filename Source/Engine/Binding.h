@@ -13,26 +13,36 @@
 #include <JuceHeader.h>
 
 #include "Control/ControllableParameter.h"
+#include "Control/ParameterSnapshot.h"
 #include "Engine/SignalBus.h"
 #include "Engine/NoiseGenerator.h"
 
 namespace engine
 {
 
+class WavetableBank;
+
 /**
  * @struct enging::Bindings
  * @brief Holds weak and strongs references to engine bindings.
  * 
  * Store reference to all the bindings a engine module could have
  *  - m_parameterMap : Holds the MIDI parameters a module could connect to
- *  - r_noiseGenerator : The noise generator modules can use to modulate their parameter
+ *  - r_noiseGenerator : The root noise generator, modules fork their own noise
+ *    stream from it to modulate their parameters
  *  - r_signalBus : The signal bus modules can use to share signal to each other
+ *  - r_parameters : The snapshot of the parameters values, updated by the
+ *    engine at the beginning of each callback
+ *  - r_wavetables : The frames the oscillators morph between, empty when
+ *    only the analytic oscillator runs
 */
 struct Bindings
 {
     std::weak_ptr<control::ParameterMap> m_parameterMap;
     NoiseGenerator& r_noiseGenerator;
     SignalBus& r_signalBus;
+    const control::ParameterSnapshot& r_parameters;
+    const WavetableBank& r_wavetables;
 };
 
 } // namespace engine
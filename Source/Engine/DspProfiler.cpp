@@ -0,0 +1,168 @@
+/*
+  ==============================================================================
+
+    DspProfiler.cpp
+    Created: 17 Oct 2026 2:21:37pm
+    Author:  maxime
+
+  ==============================================================================
+*/
+
+#include "DspProfiler.h"
+
+#include <algorithm>
+#include <csignal>
+#include <iostream>
+#include <vector>
+
+namespace engine
+{
+
+constexpr double NS_TO_US = 0.001;
+constexpr double P99_RATIO = 0.99;
+
+//==============================================================================
+juce::String DspProfiler::Report::toString() const
+{
+    auto str = juce::String("DSP profile over ") + juce::String(m_numCallbacks)
+            + " callbacks, budget " + juce::String(m_budget, 1) + "us\n";
+
+    str += juce::String("stage").paddedRight(' ', 14)
+            + juce::String("min").paddedLeft(' ', 10)
+            + juce::String("mean").paddedLeft(' ', 10)
+            + juce::String("p99").paddedLeft(' ', 10)
+            + juce::String("max").paddedLeft(' ', 10)
+            + juce::String("%budget").paddedLeft(' ', 10) + "\n";
+
+    for (auto stage = 0; stage <= Stage::MAX; ++stage)
+    {
+        auto& stats = m_stages[size_t(stage)];
+        auto budgetRatio = m_budget > 0. ? 100. * stats.m_mean / m_budget : 0.;
+
+        str += juce::String(getStageName(stage)).paddedRight(' ', 14)
+                + juce::String(stats.m_min, 2).paddedLeft(' ', 10)
+                + juce::String(stats.m_mean, 2).paddedLeft(' ', 10)
+                + juce::String(stats.m_p99, 2).paddedLeft(' ', 10)
+                + juce::String(stats.m_max, 2).paddedLeft(' ', 10)
+                + juce::String(budgetRatio, 1).paddedLeft(' ', 10) + "\n";
+    }
+
+    return str;
+}
+
+//==============================================================================
+DspProfiler::DspProfiler()
+    : m_ring(std::make_unique<std::array<Record, RING_SIZE>>()),
+      m_writeIndex(0),
+      m_budget(0.),
+      m_callbackStart(),
+      m_stageStart()
+{
+    for (auto& record : *m_ring)
+    {
+        for (auto& duration : record)
+        {
+            duration.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+const char* DspProfiler::getStageName(int stage) noexcept
+{
+    switch (stage)
+    {
+        case Stage::SYNTH:          return "synth";
+        case Stage::FILTER:         return "filter";
+        case Stage::LIMITER:        return "limiter";
+        case Stage::GAIN:           return "gain";
+        case Stage::STEREO_COPY:    return "stereo copy";
+        case Stage::MAX:            return "callback";
+        default:                    return "unknown";
+    }
+}
+
+//==============================================================================
+void DspProfiler::prepare(double blockLength) noexcept
+{
+    m_budget.store(blockLength * 1e6, std::memory_order_relaxed);
+    m_writeIndex.store(0, std::memory_order_release);
+}
+
+DspProfiler::Report DspProfiler::computeReport() const
+{
+    auto report = Report();
+    auto writeIndex = m_writeIndex.load(std::memory_order_acquire);
+
+    // The slot at writeIndex might be written while we read, so we skip it
+    auto numCallbacks = int(std::min(writeIndex, juce::uint32(RING_SIZE - 1)));
+    report.m_numCallbacks = numCallbacks;
+    report.m_budget = m_budget.load(std::memory_order_relaxed);
+
+    if (numCallbacks == 0)
+    {
+        return report;
+    }
+
+    auto durations = std::vector<double>(size_t(numCallbacks));
+    auto p99Index = size_t(std::floor(P99_RATIO * (numCallbacks - 1)));
+
+    for (auto stage = 0; stage <= Stage::MAX; ++stage)
+    {
+        auto& stats = report.m_stages[size_t(stage)];
+        auto sum = 0.;
+
+        for (auto i = 0; i < numCallbacks; ++i)
+        {
+            auto slot = (writeIndex - 1 - juce::uint32(i)) % RING_SIZE;
+            durations[size_t(i)] = (*m_ring)[slot][size_t(stage)].load(
+                    std::memory_order_relaxed) * NS_TO_US;
+            sum += durations[size_t(i)];
+        }
+
+        auto minMax = std::minmax_element(durations.begin(), durations.end());
+        stats.m_min = *minMax.first;
+        stats.m_max = *minMax.second;
+        stats.m_mean = sum / numCallbacks;
+
+        std::nth_element(durations.begin(), durations.begin() + long(p99Index),
+                durations.end());
+        stats.m_p99 = durations[p99Index];
+    }
+
+    return report;
+}
+
+//==============================================================================
+std::atomic<bool> DspProfilerReporter::s_reportRequested(false);
+
+// How often the timer checks for a SIGUSR1 request
+constexpr int REPORTER_POLLING_MS = 200;
+
+DspProfilerReporter::DspProfilerReporter(const DspProfiler& profiler, double periodS)
+    : r_profiler(profiler),
+      m_periodS(periodS),
+      m_lastReportTime(juce::Time::getMillisecondCounterHiRes() * 0.001)
+{
+    std::signal(SIGUSR1, handleSignal);
+    startTimer(REPORTER_POLLING_MS);
+}
+
+void DspProfilerReporter::timerCallback()
+{
+    auto now = juce::Time::getMillisecondCounterHiRes() * 0.001;
+    auto periodElapsed = m_periodS > 0. && now - m_lastReportTime >= m_periodS;
+
+    if (s_reportRequested.exchange(false) || periodElapsed)
+    {
+        m_lastReportTime = now;
+        std::cout << r_profiler.computeReport().toString() << std::flush;
+    }
+}
+
+void DspProfilerReporter::handleSignal(int)
+{
+    // Only async-signal-safe operations here, the report is printed by the timer
+    s_reportRequested.store(true);
+}
+
+} // namespace engine
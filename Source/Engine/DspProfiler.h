@@ -0,0 +1,195 @@
+/*
+  ==============================================================================
+
+    DspProfiler.h
+    Created: 17 Oct 2026 2:21:37pm
+    Author:  maxime
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+
+#include <JuceHeader.h>
+
+namespace engine
+{
+
+/**
+ * @class engine::DspProfiler
+ * @brief A lock-free profiler measuring the cost of each stage of the audio
+ * callback
+ *
+ * The audio thread calls beginCallback(), then endStage() after each stage and
+ * finally endCallback(). The duration of each stage is stored in a ring of the
+ * last RING_SIZE callbacks, using only relaxed atomic stores, so it is cheap
+ * enough to be always enabled.
+ *
+ * Any other thread can call computeReport() at any time to get the min, mean,
+ * p99 and max duration of each stage over the ring.
+ */
+class DspProfiler
+{
+public:
+    /**
+     * @brief List the differents stages of the audio callback
+     *
+     * When adding a new value make sure it is bounded by both 0 and Stage::MAX
+     */
+    enum Stage
+    {
+        /* The lowest value should always be 0 */
+        SYNTH = 0,          // juce::Synthesiser rendering
+        FILTER = 1,         // Filter::process
+        LIMITER = 2,        // juce::dsp::Limiter
+        GAIN = 3,           // Output gain
+        STEREO_COPY = 4,    // Mono to stereo copy
+
+        /* This should always be the highest value */
+        MAX
+    };
+
+    /**
+     * @brief Statistics of a stage over the ring, in microseconds
+     */
+    struct Statistics
+    {
+        double  m_min = 0.;
+        double  m_mean = 0.;
+        double  m_p99 = 0.;
+        double  m_max = 0.;
+    };
+
+    /**
+     * @brief Statistics of every stage, the last entry being the whole callback
+     */
+    struct Report
+    {
+        std::array<Statistics, Stage::MAX + 1>  m_stages;
+        int                                     m_numCallbacks = 0;
+        double                                  m_budget = 0.;  // in microseconds
+
+        /**
+         * @brief Format the report as a human readable table
+         */
+        juce::String toString() const;
+    };
+
+    static constexpr int    RING_SIZE = 4096;
+
+//==============================================================================
+    DspProfiler();
+
+    /**
+     * @brief Get the printable name of a stage
+     */
+    static const char* getStageName(int stage) noexcept;
+
+//==============================================================================
+    /**
+     * @brief Set the time available for each callback and clear the ring
+     * @note Must not be called while the audio thread is running
+     *
+     * @param blockLength The duration of a block in seconds
+     */
+    void prepare(double blockLength) noexcept;
+
+    /**
+     * @brief Start measuring a new callback - audio thread only
+     */
+    forcedinline void beginCallback() noexcept
+    {
+        m_callbackStart = Clock::now();
+        m_stageStart = m_callbackStart;
+    }
+
+    /**
+     * @brief Ends the measure of the given stage, which started at the end of
+     * the previous one - audio thread only
+     */
+    forcedinline void endStage(Stage stage) noexcept
+    {
+        auto now = Clock::now();
+        storeDuration(stage, now - m_stageStart);
+        m_stageStart = now;
+    }
+
+    /**
+     * @brief Ends the measure of the callback and publish it - audio thread only
+     */
+    forcedinline void endCallback() noexcept
+    {
+        storeDuration(Stage::MAX, Clock::now() - m_callbackStart);
+        m_writeIndex.store(m_writeIndex.load(std::memory_order_relaxed) + 1,
+                std::memory_order_release);
+    }
+
+//==============================================================================
+    /**
+     * @brief Compute the statistics over the ring - thread safe, NOT real-time
+     * safe
+     */
+    Report computeReport() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+    using Record = std::array<std::atomic<juce::uint32>, Stage::MAX + 1>;
+
+    forcedinline void storeDuration(int stage, Clock::duration duration) noexcept
+    {
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+        auto slot = m_writeIndex.load(std::memory_order_relaxed) % RING_SIZE;
+        (*m_ring)[slot][stage].store(juce::uint32(ns), std::memory_order_relaxed);
+    }
+
+//==============================================================================
+    std::unique_ptr<std::array<Record, RING_SIZE>>  m_ring;
+    std::atomic<juce::uint32>                       m_writeIndex;
+    std::atomic<double>                             m_budget;
+    Clock::time_point                               m_callbackStart;
+    Clock::time_point                               m_stageStart;
+};
+
+//==============================================================================
+/**
+ * @class engine::DspProfilerReporter
+ * @brief Prints the DspProfiler report from the message thread
+ *
+ * The report is printed when the process receives SIGUSR1, and periodically if
+ * a period is given.
+ */
+class DspProfilerReporter : private juce::Timer
+{
+public:
+    /**
+     * @brief Construct a new reporter and install the SIGUSR1 handler
+     *
+     * @param profiler The profiler to report
+     * @param periodS  The period of the report in seconds, 0 to only report
+     * on SIGUSR1
+     */
+    DspProfilerReporter(const DspProfiler& profiler, double periodS = 0.);
+
+private:
+    /**
+     * @name juce::Timer overrides.
+     */
+    ///@{
+    void timerCallback() override;
+    ///@}
+
+    static void handleSignal(int);
+
+//==============================================================================
+    const DspProfiler&                      r_profiler;
+    double                                  m_periodS;
+    double                                  m_lastReportTime;
+
+    static std::atomic<bool>                s_reportRequested;
+};
+
+} // namespace engine
@@ -14,6 +14,7 @@
 
 #include "Engine/Sound.h"
 #include "Engine/Voice.h"
+#include "Engine/VoicePool.h"
 #include "Engine/Oscillators/DualOscillator.h"
 #include "Engine/SignalBus.h"
 #include "Engine/Binding.h"
@@ -22,31 +23,80 @@
 
 namespace engine {
 
+// Upper bound of the size of a note message in a juce::MidiBuffer, header included
+constexpr size_t MIDI_EVENT_MAX_BYTES = 16;
+
+// The analytic mono voice never reads the wavetables, only the pool does
+static bool needsWavetables(const control::MidiBroker& midiBroker)
+{
+    return ! parameters::values::ANALYTIC_OSCILLATOR || midiBroker.getNumVoices() > 1;
+}
+
 RaciderryEngine::RaciderryEngine(control::MidiBroker& midiBroker)
+    : RaciderryEngine(midiBroker, juce::uint64(midiBroker.getNoiseSeed()))
+{
+}
+
+RaciderryEngine::RaciderryEngine(control::MidiBroker& midiBroker, juce::uint64 noiseSeed)
     : r_midiBroker(midiBroker),
-      m_noiseGenerator(0.03),
+      m_parameters(midiBroker.readParameterSnapshot()),
+      m_noiseGenerator(0.03, noiseSeed),
       m_signalBus(),
+      m_wavetables(needsWavetables(midiBroker)),
       m_synth(std::make_unique<juce::Synthesiser>()),
       m_oscWeakPtr(),
+      m_voicePool(),
+      m_noteMidiBuffer(),
       m_limiter(),
-      m_filter({midiBroker.getIdToParameterMap(), m_noiseGenerator, m_signalBus}),
+      m_filter({midiBroker.getIdToParameterMap(), m_noiseGenerator, m_signalBus, m_parameters,
+                      m_wavetables},
+              parameters::values::FILTER_OVERSAMPLING_FACTOR),
+      m_profiler(),
       m_blockLength(0),
       m_sampleRate(0.)
 {
-    // Init the Voice and Sound for the synth
-    auto voice = std::make_unique<Voice>(Bindings({
+    // The wavetables must be loaded before the oscillators are built
+    auto wavetablesDirectory = juce::File::getCurrentWorkingDirectory().getChildFile(
+            parameters::files::WAVETABLES_DIRECTORY);
+
+    if (needsWavetables(midiBroker) && m_wavetables.loadFromDirectory(wavetablesDirectory))
+    {
+        std::cout << "Loaded " << m_wavetables.getNumFrames() << " wavetables" << std::endl;
+    }
+
+    auto bindings = Bindings({
             midiBroker.getIdToParameterMap(), 
             m_noiseGenerator, 
-            m_signalBus}));
-    auto sound = std::make_unique<Sound>();
+            m_signalBus,
+            m_parameters,
+            m_wavetables});
 
-    // Get a weak pointer to the osc to update its samplerate/blocksize
-    m_oscWeakPtr = voice->getOscPtr();
+    if (midiBroker.getNumVoices() > 1)
+    {
+        // Paraphonic mode, the pool renders the notes instead of the synth
+        m_voicePool = std::make_unique<VoicePool>(
+                juce::jmin(midiBroker.getNumVoices(), VoicePool::MAX_VOICES), bindings);
+    }
+    else
+    {
+        // Init the Voice and Sound for the synth
+        auto voice = std::make_unique<Voice>(bindings);
+        auto sound = std::make_unique<Sound>();
+
+        // Get a weak pointer to the osc to update its samplerate/blocksize
+        m_oscWeakPtr = voice->getOscPtr();
+
+        // Gives the Voice and Sound to the Synth
+        m_synth->addVoice(voice.release());
+        m_synth->addSound(sound.release());
+        m_synth->setNoteStealingEnabled(true);
+    }
+
+    // Let the synth split the blocks at the exact position of each note
+    m_synth->setMinimumRenderingSubdivisionSize(1);
 
-    // Gives the Voice and Sound to the Synth
-    m_synth->addVoice(voice.release());
-    m_synth->addSound(sound.release());
-    m_synth->setNoteStealingEnabled(true);
+    // Preallocate the note buffer, so the audio thread never allocates it
+    m_noteMidiBuffer.ensureSize(size_t(control::MidiBroker::NOTE_FIFO_SIZE) * MIDI_EVENT_MAX_BYTES);
 
     // Set the limiter
     m_limiter.setRelease(parameters::values::LIMITER_RELEASE_MS);
@@ -72,6 +122,14 @@ void RaciderryEngine::audioDeviceIOCallback(const float **inputChannelData,
     jassert(numInputChannels == 0);
     jassert(numOutputChannels == 2);
 
+    // Juce timestamps the incoming midi messages with this clock
+    renderNextBlock(outputChannelData, numSamples,
+            juce::Time::getMillisecondCounterHiRes() * 0.001);
+}
+
+void RaciderryEngine::renderNextBlock(float** outputChannelData, int numSamples,
+        double callbackTime)
+{
     // These three structures points toward the same memory block
     auto outputBuffer = juce::AudioBuffer<float>(outputChannelData, 1, numSamples);
     auto outputBlock = juce::dsp::AudioBlock<float>(
@@ -82,40 +140,82 @@ void RaciderryEngine::audioDeviceIOCallback(const float **inputChannelData,
     );
     auto outputContext = juce::dsp::ProcessContextReplacing(outputBlock);
 
+    m_profiler.beginCallback();
+
+    // 0. Every module reads the same parameters values during the whole block
+    m_parameters = r_midiBroker.readParameterSnapshot();
+
     // 1. The synth produces the main output
-    m_synth->renderNextBlock(outputBuffer, r_midiBroker.getNoteMidiBuffer(), 0, numSamples);
+    r_midiBroker.popNoteMidiBuffer(m_noteMidiBuffer,
+            callbackTime - numSamples / m_sampleRate, m_sampleRate, numSamples);
+    if (m_voicePool != nullptr)
+    {
+        m_voicePool->renderNextBlock(outputBuffer, m_noteMidiBuffer, 0, numSamples);
+    }
+    else
+    {
+        m_synth->renderNextBlock(outputBuffer, m_noteMidiBuffer, 0, numSamples);
+    }
+    m_profiler.endStage(DspProfiler::SYNTH);
 
     // 2. We apply the filter on the synth output
     m_filter.process(outputContext);
+    m_profiler.endStage(DspProfiler::FILTER);
 
     // 3. We use the limiter to prevent the audio from saturating
     m_limiter.process(outputContext);
-
+    m_profiler.endStage(DspProfiler::LIMITER);
 
     // 4. We duplicate and attenuate the signal to produce stereo output from
     // our mono signal
     outputBuffer.applyGain(0.5);
+    m_profiler.endStage(DspProfiler::GAIN);
     memcpy(outputChannelData[1], outputChannelData[0], numSamples * sizeof(float));
+    m_profiler.endStage(DspProfiler::STEREO_COPY);
+
+    m_profiler.endCallback();
 }
 
 void RaciderryEngine::audioDeviceAboutToStart(juce::AudioIODevice* device)
 {
-    m_sampleRate = device->getCurrentSampleRate();
-    auto numSamples = juce::uint32(device->getCurrentBufferSizeSamples());
+    prepare(device->getCurrentSampleRate(), device->getCurrentBufferSizeSamples());
+}
+
+void RaciderryEngine::audioDeviceStopped()
+{
+    reset();
+}
+
+//==============================================================================
+void RaciderryEngine::prepare(double sampleRate, int blockSize)
+{
+    m_sampleRate = sampleRate;
+    auto numSamples = juce::uint32(blockSize);
     m_blockLength = numSamples / m_sampleRate;
-    std::cout << "About to start : " << m_sampleRate << " : " << numSamples << std::endl;
 
+    m_signalBus.prepare(blockSize);
     m_synth->setCurrentPlaybackSampleRate(m_sampleRate);
     m_limiter.prepare({m_sampleRate, numSamples, 1});
     m_filter.prepare(m_sampleRate, numSamples);
 
+    std::cout << "About to start : " << m_sampleRate << " : " << numSamples
+              << " (noise seed " << m_noiseGenerator.getSeed() << ", filter "
+              << m_filter.getOversamplingFactor() << "x oversampled, "
+              << m_filter.getLatencyInSamples() << " samples of latency)" << std::endl;
+    m_profiler.prepare(m_blockLength);
+
     if (auto safePtr = m_oscWeakPtr.lock())
     {
         safePtr->prepare(m_sampleRate, numSamples);
     }
+
+    if (m_voicePool != nullptr)
+    {
+        m_voicePool->prepare(m_sampleRate, blockSize);
+    }
 }
 
-void RaciderryEngine::audioDeviceStopped()
+void RaciderryEngine::reset()
 {
     m_blockLength = 0.;
     m_sampleRate = 0.;
@@ -127,6 +227,11 @@ void RaciderryEngine::audioDeviceStopped()
     {
         safePtr->reset();
     }
+
+    if (m_voicePool != nullptr)
+    {
+        m_voicePool->reset();
+    }
 }
 
 
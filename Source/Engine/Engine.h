@@ -13,7 +13,9 @@
 #include <JuceHeader.h>
 
 #include "Engine/Filter/Filter.h"
+#include "Engine/Oscillators/WavetableBank.h"
 #include "Engine/NoiseGenerator.h"
+#include "Engine/DspProfiler.h"
 
 #include "Control/MidiBroker.h"
 #include "Control/ControllableParameter.h"
@@ -21,6 +23,7 @@
 namespace engine {
 
 class DualOscillator;
+class VoicePool;
 
 /**
  * @class engine::RaciderryEngine
@@ -29,11 +32,27 @@ class DualOscillator;
  * 
  * This engine manages all the audio modules, init and reset them when needed, 
  * and call them in the appropriate order to produce the audio output
+ * 
+ * The notes are either played by a single engine::Voice through a
+ * juce::Synthesiser (the mono mode), or by an engine::VoicePool when the
+ * configuration asks for several voices (the paraphonic mode)
+ * 
+ * The parameters values are copied from the MidiBroker once per callback, and
+ * read by the modules from this snapshot through their Bindings
+ * 
+ * The wavetables of the oscillators are loaded from the wavetables directory
+ * when it holds wav files, the default saw and square are used otherwise
  */
 class RaciderryEngine :   public juce::AudioIODeviceCallback
 {
 public:
     RaciderryEngine(control::MidiBroker& midiBroker);
+    /**
+     * @brief Build an engine with the given noise seed, instead of the one of
+     * the configuration. Two engines with the same seed fed with the same
+     * notes produce the exact same output
+     */
+    RaciderryEngine(control::MidiBroker& midiBroker, juce::uint64 noiseSeed);
     ~RaciderryEngine();
 
 //==============================================================================
@@ -47,15 +66,56 @@ public:
     void audioDeviceStopped() override;
     ///@}
 
+//==============================================================================
+    /**
+     * @brief Prepare every audio module for the given processing context
+     * 
+     * Called by audioDeviceAboutToStart(), but can also be used directly to
+     * run the engine without any audio device (offline rendering, tests...)
+     * 
+     * @param sampleRate The sample rate the engine will run at
+     * @param blockSize  The maximum number of samples per callback
+     */
+    void prepare(double sampleRate, int blockSize);
+    /**
+     * @brief Reset every audio module, called by audioDeviceStopped()
+     */
+    void reset();
+
+    /**
+     * @brief Render the next block, called by audioDeviceIOCallback()
+     * 
+     * The notes received during the block preceding callbackTime are rendered
+     * at their position relative to it, which gives a sample accurate timing
+     * with a constant latency of one block.
+     * 
+     * @param outputChannelData The two output channels
+     * @param numSamples        The number of samples to render
+     * @param callbackTime      The time of the callback in seconds, in the same
+     * clock than the midi messages timestamps
+     */
+    void renderNextBlock(float** outputChannelData, int numSamples, double callbackTime);
+
+    /**
+     * @brief Get the profiler measuring each stage of audioDeviceIOCallback()
+     */
+    const DspProfiler& getProfiler() const noexcept { return m_profiler; }
+
 private:
 //==============================================================================
     control::MidiBroker&                            r_midiBroker;
+    // Parameters values for the current callback, read by the modules
+    control::ParameterSnapshot                      m_parameters;
     NoiseGenerator                                  m_noiseGenerator;
     SignalBus                                       m_signalBus;
+    WavetableBank                                   m_wavetables;
     std::unique_ptr<juce::Synthesiser>              m_synth;
     std::weak_ptr<DualOscillator>                   m_oscWeakPtr;
+    std::unique_ptr<VoicePool>                      m_voicePool;
+    juce::MidiBuffer                                m_noteMidiBuffer;
     juce::dsp::Limiter<float>                       m_limiter;
     Filter                                          m_filter;
+    DspProfiler                                     m_profiler;
     
     double                                          m_blockLength;
     double                                          m_sampleRate;
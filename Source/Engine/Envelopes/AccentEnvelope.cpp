@@ -13,8 +13,6 @@
 #include "Engine/Envelopes/Utils.h"
 #include "Engine/SignalBus.h"
 
-#include "Utils/Identifiers.h"
-
 namespace engine
 {
 
@@ -25,34 +23,21 @@ constexpr double ATTACK_S = 0.005;
 constexpr float  AMOUNT_MIN = 0.2;
 
 AccentEnvelope::AccentEnvelope(Bindings bindings)
-    : m_decay(),
+    : r_parameters(bindings.r_parameters),
+      m_parametersVersion(0),
       m_crtMax(1.0),
+      m_decayCoeff(0.f),
+      m_decayBase(0.f),
+      m_accent(bindings.r_parameters, control::ParameterSnapshot::ACCENT),
       m_state(State::idle),
       m_noteAmount(0.0),
       r_signalBus(bindings.r_signalBus)
 {
-    // bind to controllable parameters
-    auto parameterMap = bindings.m_parameterMap.lock();
-    jassert(parameterMap != nullptr);
-
-    m_decay = (*parameterMap)[identifiers::controls::ACCENT_DECAY];
-    m_accent = (*parameterMap)[identifiers::controls::ACCENT];
-    jassert(m_decay.isValid());
-    jassert(m_accent.isValid());
-    m_decay.addListener(this);
     updateAttack();
-    updateDecay();
+    updateDecay(true);
 }
 
 //==============================================================================
-void AccentEnvelope::changeListenerCallback(juce::ChangeBroadcaster* source)
-{
-    if (m_decay == source)
-    {
-        updateDecay();
-    }
-}
-
 void AccentEnvelope::setSampleRate(double sampleRate)
 {
     jassert(sampleRate > 0.);
@@ -63,7 +48,8 @@ void AccentEnvelope::setSampleRate(double sampleRate)
 
         // Recompute the rates by calling the setters
         updateAttack();
-        updateDecay();
+        updateDecay(true);
+        m_accent.prepare(sampleRate, 0);
     }
 }
 
@@ -71,6 +57,7 @@ void AccentEnvelope::reset()
 {
     m_state = State::idle;
     m_lastEnvValue.set(0);
+    m_accent.reset();
 }
 
 void AccentEnvelope::noteOn(float velocity)
@@ -104,28 +91,36 @@ void AccentEnvelope::noteOff()
     }
 }
 
-void AccentEnvelope::nextValue(int numSamples)
+void AccentEnvelope::nextValue(int startSample, int numSamples)
 {
     jassert(numSamples > 0);
+    jassert(startSample + numSamples <= r_signalBus.getModulationBufferSize());
 
-    auto envBlockMax = float(0.);
+    updateDecay();
+    m_accent.updateTarget();
 
+    auto envBlockMax = float(0.);
+    auto amount = float(0.);
+    auto* modulation = r_signalBus.getModulationWritePointer(SignalBus::SignalId::AEG)
+            + startSample;
 
     while(numSamples--)
     {
         computeNextEnvValue();
-        if (m_lastEnvValue.get() > envBlockMax)
+        auto envValue = m_lastEnvValue.get();
+        amount = AMOUNT_MIN + m_noteAmount * m_accent.getNextValue();
+
+        // Compute the actual value once modulated
+        *modulation++ = m_crtMax.get() * envValue * amount;
+
+        if (envValue > envBlockMax)
         {
-            envBlockMax = m_lastEnvValue.get();
+            envBlockMax = envValue;
         }
     }
 
-    // Compute the actual value once modulated
-    auto envValue = m_crtMax.get() * envBlockMax;
-    auto modulatedValue = envValue * (AMOUNT_MIN + m_noteAmount * m_accent.getCurrentValue());
-
-    // We send the mean value in the signal bus
-    r_signalBus.updateSignal(SignalBus::SignalId::AEG, modulatedValue);
+    // We send the max value in the signal bus
+    r_signalBus.updateSignal(SignalBus::SignalId::AEG, m_crtMax.get() * envBlockMax * amount);
 }
 
 void AccentEnvelope::updateAttack()
@@ -135,18 +130,20 @@ void AccentEnvelope::updateAttack()
     m_attackBase = (1.0 + ATTACK_RATIO) * (1.0 - m_attackCoeff);
 }
 
-void AccentEnvelope::updateDecay()
+void AccentEnvelope::updateDecay(bool force) noexcept
 {
-    jassert(m_decay.getCurrentValue() > 0.);
-    // DBG("New decay : " + juce::String(decay));
-    auto decNumSamples = int(m_decay.getCurrentValue() * m_sampleRate.get());
-
-    // Settings these two consecutively without mutex could lead to a 
-    // computation error on one sample if the read performs between the two sets
-    // However the computation error is bounded, inaudible, and allows lock-free
-    // updates
-    m_decayCoeff.set(computeExpEnvCoeff(decNumSamples, DECAY_RATIO));
-    m_decayBase.set(( - DECAY_RATIO ) * (1.0 - m_decayCoeff.get()));
+    // The version changes each time the midi thread publishes new values
+    if (! force && r_parameters.m_version == m_parametersVersion)
+    {
+        return;
+    }
+
+    m_parametersVersion = r_parameters.m_version;
+    auto decNumSamples = int(r_parameters.getValue(control::ParameterSnapshot::ACCENT_DECAY)
+            * m_sampleRate.get());
+
+    m_decayCoeff = float(computeExpEnvCoeff(decNumSamples, DECAY_RATIO));
+    m_decayBase = float(( - DECAY_RATIO ) * (1.0 - m_decayCoeff));
 }
 
 void AccentEnvelope::computeNextEnvValue()
@@ -170,7 +167,7 @@ void AccentEnvelope::computeNextEnvValue()
             break;
 
         case State::decay:
-            newValue = m_decayBase.get() + m_lastEnvValue.get() * m_decayCoeff.get();
+            newValue = m_decayBase + m_lastEnvValue.get() * m_decayCoeff;
             if (newValue <= 0)
             {
                 newValue = 0;
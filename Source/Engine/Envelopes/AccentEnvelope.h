@@ -13,6 +13,7 @@
 #include <JuceHeader.h>
 
 #include "Engine/Binding.h"
+#include "Engine/ParameterRamp.h"
 
 namespace engine
 {
@@ -26,23 +27,19 @@ namespace engine
  * Computes a Attack-Decay envelope, with fixed sharp attack and controllable
  * decay. It internally updates its value in the Signal Bus with the max value
  * of each block
+ * 
+ * Like engine::VCAEnvelope, the decay coefficients are recomputed at the
+ * beginning of a block when the version of the parameters snapshot changed
  */
-class AccentEnvelope : public juce::ChangeListener
+class AccentEnvelope
 {
 public:
     AccentEnvelope(Bindings bindings);
 
 //==============================================================================
     /**
-     * @name juce::ChangeListener overrides.
-     */
-    ///@{
-    void changeListenerCallback(juce::ChangeBroadcaster* source) override;
-    ///@}
-
-//==============================================================================
-    /**
-     * @brief Updates the sample rate - thread safe
+     * @brief Updates the sample rate, and recompute the coefficients
+     * @note Must not be called while processing
      * 
      * @param sampleRate The new sample rate
      */
@@ -61,32 +58,39 @@ public:
     void noteOff();
 
     /**
-     * @brief Computes and updates the next value for the Accent envelope
+     * @brief Computes the next values of the Accent envelope, and writes them
+     * into the AEG modulation buffer
      * 
+     * @param startSample The index where to start in the modulation buffer
      * @param numSamples The number of samples to the next point
      */
-    void nextValue(int numSamples);
+    void nextValue(int startSample, int numSamples);
 
 private:
     enum class State {idle, attack, decay};
 
     void updateAttack();
-    void updateDecay();
+    /**
+     * @brief Recompute the decay coefficients if the parameters changed since
+     * the last call, or if force is true
+     */
+    void updateDecay(bool force = false) noexcept;
 
     forcedinline void computeNextEnvValue();
 
 //==============================================================================
 
     // Parameters the user can control
-    control::ControllableParameter          m_decay;
-    control::ControllableParameter          m_accent;
+    const control::ParameterSnapshot&       r_parameters;
+    juce::uint32                            m_parametersVersion;
 
     /// AD compute values
     float                   m_attackCoeff;
     float                   m_attackBase;
     juce::Atomic<float>     m_crtMax;
-    juce::Atomic<float>     m_decayCoeff;
-    juce::Atomic<float>     m_decayBase;
+    float                   m_decayCoeff;
+    float                   m_decayBase;
+    ParameterRamp           m_accent;
 
     // Misc
     juce::Atomic<float>     m_sampleRate;
@@ -13,8 +13,6 @@
 #include "Engine/Envelopes/Utils.h"
 #include "Engine/SignalBus.h"
 
-#include "Utils/Identifiers.h"
-
 
 namespace engine {
 
@@ -24,54 +22,19 @@ constexpr double DECAY_RATIO = 0.0001;
 constexpr double RELEASE_RATIO = 0.0001;
 
 VCAEnvelope::VCAEnvelope(Bindings bindings)
-    : m_attack(),
-      m_decay(),
-      m_sustain(),
-      m_release(),
+    : r_parameters(bindings.r_parameters),
+      m_parametersVersion(0),
+      m_attackCoeff(0.f),
+      m_attackBase(0.f),
+      m_decayCoeff(0.f),
+      m_decayBase(0.f),
+      m_releaseCoeff(0.f),
+      m_releaseBase(0.f),
+      m_sustain(bindings.r_parameters, control::ParameterSnapshot::SUSTAIN),
       m_state(State::idle),
       m_signalBus(bindings.r_signalBus)
 {
-    // bind to controllable parameters
-    auto parameterMap = bindings.m_parameterMap.lock();
-    jassert(parameterMap != nullptr);
-
-    m_attack = (*parameterMap)[identifiers::controls::ATTACK];
-    m_decay = (*parameterMap)[identifiers::controls::DECAY];
-    m_sustain = (*parameterMap)[identifiers::controls::SUSTAIN];
-    m_release = (*parameterMap)[identifiers::controls::RELEASE];
-    jassert(m_attack.isValid());
-    jassert(m_decay.isValid());
-    jassert(m_sustain.isValid());
-    jassert(m_release.isValid());
-    m_attack.addListener(this);
-    m_decay.addListener(this);
-    m_release.addListener(this);
-    m_sustain.addListener(this);
-    updateAttack();
-    updateDecay();
-    updateRelease();
-    updateSustain();
-}
-
-//==============================================================================
-void VCAEnvelope::changeListenerCallback(juce::ChangeBroadcaster* source)
-{
-    if (m_attack == source)
-    {
-        updateAttack();
-    }
-    else if (m_decay == source)
-    {
-        updateDecay();
-    }
-    else if (m_release ==  source)
-    {
-        updateRelease();
-    }
-    else if (m_sustain == source)
-    {
-        updateSustain();
-    }
+    updateCoefficients(true);
 }
 
 //==============================================================================
@@ -82,11 +45,8 @@ void VCAEnvelope::setSampleRate(double sampleRate)
     if (sampleRate != m_sampleRate.get())
     {
         m_sampleRate.set(sampleRate);
-
-        // Recompute the rates by calling the setters
-        updateAttack();
-        updateDecay();
-        updateRelease();
+        m_sustain.prepare(sampleRate, 0);
+        updateCoefficients(true);
     }
 }
 
@@ -94,6 +54,7 @@ void VCAEnvelope::reset()
 {
     m_state = State::idle;
     m_lastEnvValue.set(0);
+    m_sustain.reset();
 }
 
 void VCAEnvelope::noteOn()
@@ -117,75 +78,71 @@ void VCAEnvelope::applyAmpEnvelopeToBuffer(juce::AudioBuffer<float>& buffer,
         int startSample, int numSamples)
 {
     jassert(numSamples > 0);
+    jassert(startSample + numSamples <= m_signalBus.getModulationBufferSize());
 
     auto sum = float(0);
     auto count = numSamples;
     auto* data = buffer.getWritePointer(0) + startSample;
+    auto* modulation = m_signalBus.getModulationWritePointer(SignalBus::SignalId::VEG)
+            + startSample;
+    updateCoefficients();
+    m_sustain.updateTarget();
 
     while(numSamples--)
     {
         computeNextEnvValue();
-        *data *= m_lastEnvValue.get();
-        sum += m_lastEnvValue.get();
-        data++;
+        auto envValue = m_lastEnvValue.get();
+        *data++ *= envValue;
+        *modulation++ = envValue;
+        sum += envValue;
     }
     
     // We send the mean value to others units (filter, ...)
     m_signalBus.updateSignal(SignalBus::SignalId::VEG, sum/count);
 }
 
-void VCAEnvelope::updateAttack()
+void VCAEnvelope::writeIdleModulation(int startSample, int numSamples)
 {
-    // DBG("New attack : " + juce::String(attack));
-    jassert(m_attack.getCurrentValue() > 0.);
-    auto atkNumSamples = int(m_attack.getCurrentValue() * m_sampleRate.get());
-
-    // Settings these two consecutively without mutex could lead to a 
-    // computation error on one sample if the read performs between the two sets
-    // However the computation error is bounded, inaudible, and allows lock-free
-    // updates
-    m_attackCoeff.set(computeExpEnvCoeff(atkNumSamples, ATTACK_RATIO));
-    m_attackBase.set((1.0 + ATTACK_RATIO) * (1.0 - m_attackCoeff.get()));
-}
+    jassert(! isActive());
+    jassert(startSample + numSamples <= m_signalBus.getModulationBufferSize());
 
-void VCAEnvelope::updateDecay()
-{
-    jassert(m_decay.getCurrentValue() > 0.);
-    // DBG("New decay : " + juce::String(decay));
-    auto decNumSamples = int(m_decay.getCurrentValue() * m_sampleRate.get());
-
-    // Settings these two consecutively without mutex could lead to a 
-    // computation error on one sample if the read performs between the two sets
-    // However the computation error is bounded, inaudible, and allows lock-free
-    // updates
-    m_decayCoeff.set(computeExpEnvCoeff(decNumSamples, DECAY_RATIO));
-    m_decayBase.set((m_sustain.getCurrentValue() - DECAY_RATIO) * (1.0 - m_decayCoeff.get()));
+    auto* modulation = m_signalBus.getModulationWritePointer(SignalBus::SignalId::VEG);
+    juce::FloatVectorOperations::fill(modulation + startSample, m_lastEnvValue.get(), numSamples);
 }
 
-void VCAEnvelope::updateRelease()
+void VCAEnvelope::updateCoefficients(bool force) noexcept
 {
-    jassert(m_release.getCurrentValue() > 0.);
-    // DBG("New release : " + juce::String(release));
-    auto relNumSamples = int(m_release.getCurrentValue() * m_sampleRate.get());
-
-    // Settings these two consecutively without mutex could lead to a 
-    // computation error on one sample if the read performs between the two sets
-    // However the computation error is bounded, inaudible, and allows lock-free
-    // updates
-    m_releaseCoeff.set(computeExpEnvCoeff(relNumSamples, RELEASE_RATIO));
-    m_releaseBase.set( - RELEASE_RATIO * (1.0 - m_releaseCoeff.get()));
-}
+    // The version changes each time the midi thread publishes new values
+    if (! force && r_parameters.m_version == m_parametersVersion)
+    {
+        return;
+    }
 
-void VCAEnvelope::updateSustain()
-{
-    jassert(m_sustain.getCurrentValue() >= 0. && m_sustain.getCurrentValue() <= 1.0);
-    // DBG("New sustain : " + juce::String(sustain));
-    m_decayBase.set((m_sustain.getCurrentValue() - DECAY_RATIO) * (1.0 - m_decayCoeff.get()));
+    m_parametersVersion = r_parameters.m_version;
+
+    auto attack = r_parameters.getValue(control::ParameterSnapshot::ATTACK);
+    auto decay = r_parameters.getValue(control::ParameterSnapshot::DECAY);
+    auto release = r_parameters.getValue(control::ParameterSnapshot::RELEASE);
+    auto sustain = r_parameters.getValue(control::ParameterSnapshot::SUSTAIN);
+    jassert(sustain >= 0. && sustain <= 1.0);
+
+    auto atkNumSamples = int(attack * m_sampleRate.get());
+    auto decNumSamples = int(decay * m_sampleRate.get());
+    auto relNumSamples = int(release * m_sampleRate.get());
+
+    m_attackCoeff = float(computeExpEnvCoeff(atkNumSamples, ATTACK_RATIO));
+    m_attackBase = float((1.0 + ATTACK_RATIO) * (1.0 - m_attackCoeff));
+    m_decayCoeff = float(computeExpEnvCoeff(decNumSamples, DECAY_RATIO));
+    m_decayBase = float((sustain - DECAY_RATIO) * (1.0 - m_decayCoeff));
+    m_releaseCoeff = float(computeExpEnvCoeff(relNumSamples, RELEASE_RATIO));
+    m_releaseBase = float(- RELEASE_RATIO * (1.0 - m_releaseCoeff));
 }
 
 void VCAEnvelope::computeNextEnvValue()
 {
     float newValue;
+    // The sustain ramp moves on every sample, whatever the stage
+    auto sustain = m_sustain.getNextValue();
 
     switch(m_state.get())
     {
@@ -193,7 +150,7 @@ void VCAEnvelope::computeNextEnvValue()
             break;
 
         case State::attack:
-            newValue = m_attackBase.get() + m_lastEnvValue.get() * m_attackCoeff.get();
+            newValue = m_attackBase + m_lastEnvValue.get() * m_attackCoeff;
             if (newValue >= 1.0)
             {
                 newValue = 1.0;
@@ -203,20 +160,21 @@ void VCAEnvelope::computeNextEnvValue()
             break;
 
         case State::decay:
-            newValue = m_decayBase.get() + m_lastEnvValue.get() * m_decayCoeff.get();
-            if (newValue <= m_sustain.getCurrentValue())
+            newValue = m_decayBase + m_lastEnvValue.get() * m_decayCoeff;
+            if (newValue <= sustain)
             {
-                newValue = m_sustain.getCurrentValue();
+                newValue = sustain;
                 m_state.set(State::sustain);
             }
             m_lastEnvValue.set(newValue);
             break;
 
         case State::sustain:
+            m_lastEnvValue.set(sustain);
             break;
         
         case State::release:
-            newValue = m_releaseBase.get() + m_lastEnvValue.get() * m_releaseCoeff.get();
+            newValue = m_releaseBase + m_lastEnvValue.get() * m_releaseCoeff;
             if (newValue <= 0.0)
             {
                 newValue = 0.0;
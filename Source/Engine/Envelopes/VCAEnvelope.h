@@ -13,6 +13,7 @@
 #include <JuceHeader.h>
 
 #include "Engine/Binding.h"
+#include "Engine/ParameterRamp.h"
 
 namespace engine
 {
@@ -25,27 +26,25 @@ namespace engine
  * 
  * ADSR exponential envelope with controllable values. It also internally 
  * updates its value in the SignalBus with the mean value of each block
+ * 
+ * The coefficients are recomputed on the audio thread, at the beginning of a
+ * block, when the version of the parameters snapshot changed. They are never
+ * read while being updated. The sustain level is smoothed, and followed by
+ * the sustain stage.
  */
-class VCAEnvelope : public juce::ChangeListener
+class VCAEnvelope
 {
 public:
     VCAEnvelope(Bindings bindings);
 
-//==============================================================================
-    /**
-     * @name juce::ChangeListener overrides.
-     */
-    ///@{
-    void changeListenerCallback(juce::ChangeBroadcaster* source) override;
-    ///@}
-
 //==============================================================================
     /**
      * @brief Returns true if the env is in an active stage
      */
     bool isActive() { return m_state.get() != State::idle; }
     /**
-     * @brief Updates the sample rate - thread safe
+     * @brief Updates the sample rate, and recompute the coefficients
+     * @note Must not be called while processing
      * 
      * @param sampleRate The new sample rate
      */
@@ -64,7 +63,8 @@ public:
     void noteOff();
 
     /**
-     * @brief Apply the amplitude ADSR envelope to the output buffer
+     * @brief Apply the amplitude ADSR envelope to the output buffer, and
+     * writes the envelope into the VEG modulation buffer
      * 
      * @param buffer The buffer to reshape
      * @param startSample The index where to start in the buffer
@@ -72,13 +72,23 @@ public:
      */
     void applyAmpEnvelopeToBuffer(juce::AudioBuffer<float>& buffer, int startSample, int numSamples);
 
+    /**
+     * @brief Writes the envelope into the VEG modulation buffer when there is
+     * no audio to reshape. The envelope is expected to be idle
+     * 
+     * @param startSample The index where to start in the modulation buffer
+     * @param numSamples The number of samples to write from the start point
+     */
+    void writeIdleModulation(int startSample, int numSamples);
+
 private:
     enum class State {idle, attack, decay, sustain, release};
 
-    void updateAttack();
-    void updateDecay();
-    void updateRelease();
-    void updateSustain();
+    /**
+     * @brief Recompute the coefficients if the parameters changed since the
+     * last call, or if force is true
+     */
+    void updateCoefficients(bool force = false) noexcept;
 
     forcedinline void computeNextEnvValue();
     // forcedinline double computeEnvCoeff(int rateInSample, double targetRatio);
@@ -86,19 +96,18 @@ private:
 //==============================================================================
 
     // Parameters the user can control
-    control::ControllableParameter          m_attack;
-    control::ControllableParameter          m_decay;
-    control::ControllableParameter          m_release;
-    control::ControllableParameter          m_sustain;
+    const control::ParameterSnapshot&       r_parameters;
+    juce::uint32                            m_parametersVersion;
 
     /// Real Time properties
-    // ADSR
-    juce::Atomic<float>     m_attackCoeff;
-    juce::Atomic<float>     m_attackBase;
-    juce::Atomic<float>     m_decayCoeff;
-    juce::Atomic<float>     m_decayBase;
-    juce::Atomic<float>     m_releaseCoeff;
-    juce::Atomic<float>     m_releaseBase;
+    // ADSR, only accessed by the audio thread
+    float                   m_attackCoeff;
+    float                   m_attackBase;
+    float                   m_decayCoeff;
+    float                   m_decayBase;
+    float                   m_releaseCoeff;
+    float                   m_releaseBase;
+    ParameterRamp           m_sustain;
 
     // Misc
     juce::Atomic<float>     m_sampleRate;
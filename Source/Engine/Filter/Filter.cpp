@@ -21,115 +21,195 @@ namespace engine
 constexpr float ENV_MOD_RATIO_AMMOUNT = 0.5;
 constexpr float ACCENT_RATIO_AMMOUNT = 0.25;
 constexpr float OBERHEIM_GAIN_REDUCTION = -9.0;
+// Number of samples between two updates of the cutoff
+constexpr int   MODULATION_RATE = 16;
 
-Filter::Filter(Bindings bindings)
-    : m_oberheimFilter(nullptr),
+Filter::Filter(Bindings bindings, int oversamplingFactor)
+    : m_oberheimFilter(),
       m_open303Filter(),
-      r_noiseGenerator(bindings.r_noiseGenerator),
+      m_noiseGenerator(bindings.r_noiseGenerator.fork(NoiseGenerator::FILTER)),
       r_signalBus(bindings.r_signalBus),
+      m_cutoffRatio(bindings.r_parameters, control::ParameterSnapshot::CUTOFF, true),
+      m_resonance(bindings.r_parameters, control::ParameterSnapshot::RESONANCE),
+      m_resonanceRatio(bindings.r_parameters, control::ParameterSnapshot::RESONANCE, true),
+      m_envMod(bindings.r_parameters, control::ParameterSnapshot::ENV_MOD),
+      m_filtersMix(bindings.r_parameters, control::ParameterSnapshot::FILTER_MIX),
       m_mixBuffer(),
+      m_oversampling(),
+      m_oversamplingOrder(juce::jlimit(0, 2,
+              juce::findHighestSetBit(juce::uint32(oversamplingFactor)))),
       m_cutoffFreq(),
-      m_resonance(),
-      m_drive(),
-      m_envMod()
+      m_maxCutoff(0.f),
+      m_maxResonance(0.f)
 {
-    // Bind to the controllable parameters
+    // Bind to the controllable parameters scales
     auto parameterMap = bindings.m_parameterMap.lock();
     jassert(parameterMap != nullptr);
 
     m_cutoffFreq = (*parameterMap)[identifiers::controls::CUTOFF];
-    m_resonance = (*parameterMap)[identifiers::controls::RESONANCE];
-    m_envMod = (*parameterMap)[identifiers::controls::ENV_MOD];
-    m_filtersMix = (*parameterMap)[identifiers::controls::FILTER_MIX];
+    auto resonance = (*parameterMap)[identifiers::controls::RESONANCE];
     jassert(m_cutoffFreq.isValid());
-    jassert(m_resonance.isValid());
-    jassert(m_envMod.isValid());
-    jassert(m_filtersMix.isValid());
+    jassert(resonance.isValid());
+    m_maxCutoff = m_cutoffFreq.getScaledValueForUnscaledRatio(1.f);
+    m_maxResonance = resonance.getScaledValueForUnscaledRatio(1.f);
 
     // Set the filter to the proper mode
     m_open303Filter.setMode(rosic::TeeBeeFilter::TB_303);
     m_open303Filter.setFeedbackHighpassCutoff(180);
+
+    // The polyphase IIR adds less latency than the FIR, and no pre-ringing
+    jassert(oversamplingFactor == getOversamplingFactor());
+    if (m_oversamplingOrder > 0)
+    {
+        m_oversampling = std::make_unique<juce::dsp::Oversampling<float>>(1,
+                size_t(m_oversamplingOrder),
+                juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR);
+    }
 }
 
 //==============================================================================
 void Filter::prepare(float sampleRate, int blockSize)
 {
-    m_oberheimFilter = std::make_unique<OberheimVariationMoog>(sampleRate);
-    m_open303Filter.setSampleRate(sampleRate);
-    m_mixBuffer.setSize(1, blockSize);
+    // Only the filters run at the oversampled rate, not the ramps
+    auto filterSampleRate = sampleRate * getOversamplingFactor();
+    m_oberheimFilter.prepare(filterSampleRate);
+    m_open303Filter.setSampleRate(filterSampleRate);
+    m_mixBuffer.setSize(1, blockSize * getOversamplingFactor());
+
+    if (m_oversampling != nullptr)
+    {
+        m_oversampling->initProcessing(size_t(blockSize));
+    }
+
+    m_cutoffRatio.prepare(sampleRate, blockSize);
+    m_resonance.prepare(sampleRate, blockSize);
+    m_resonanceRatio.prepare(sampleRate, blockSize);
+    m_envMod.prepare(sampleRate, blockSize);
+    m_filtersMix.prepare(sampleRate, blockSize);
 }
 
 void Filter::reset()
 {
     m_oberheimFilter.reset();
+    m_open303Filter.reset();
     m_mixBuffer.clear();
+    m_cutoffRatio.reset();
+    m_resonance.reset();
+    m_resonanceRatio.reset();
+    m_envMod.reset();
+    m_filtersMix.reset();
+
+    if (m_oversampling != nullptr)
+    {
+        m_oversampling->reset();
+    }
+}
+
+float Filter::getLatencyInSamples() const noexcept
+{
+    return m_oversampling != nullptr ? m_oversampling->getLatencyInSamples() : 0.f;
 }
 
 void Filter::process(juce::dsp::ProcessContextReplacing<float>& context)
 {
-    // Get the modulation signals
-    float megValue = 0.0;
-    float accent = 0.0;
+    // Get the per sample modulation signals
+    auto outputBlock = context.getOutputBlock();
+    auto numSamples = int(outputBlock.getNumSamples());
+    jassert(numSamples <= r_signalBus.getModulationBufferSize());
+    auto* vegSignal = r_signalBus.getModulationReadPointer(SignalBus::SignalId::VEG);
+    auto* aegSignal = r_signalBus.getModulationReadPointer(SignalBus::SignalId::AEG);
+
+    // The noise is applied once per block
+    auto oberheimCutoffNoise = m_noiseGenerator.getNoiseFactor();
+    auto open303CutoffNoise = m_noiseGenerator.getNoiseFactor();
+    auto oberheimResonanceNoise = m_noiseGenerator.getNoiseFactor();
+    auto open303ResonanceNoise = m_noiseGenerator.getNoiseFactor() * 100 / m_maxResonance;
+
+    // The smoothed parameters, read every few samples except for the mix
+    m_cutoffRatio.updateTarget();
+    m_resonance.updateTarget();
+    m_resonanceRatio.updateTarget();
+    m_envMod.updateTarget();
+    m_filtersMix.updateTarget();
+    auto* cutoffRatio = m_cutoffRatio.getNextRamp(numSamples);
+    auto* resonance = m_resonance.getNextRamp(numSamples);
+    auto* resonanceRatio = m_resonanceRatio.getNextRamp(numSamples);
+    auto* envMod = m_envMod.getNextRamp(numSamples);
+    auto* mixRatio = m_filtersMix.getNextRamp(numSamples);
+
+    // Prepare audio buffers for processing, at the oversampled rate
+    auto filterBlock = m_oversampling != nullptr
+            ? m_oversampling->processSamplesUp(outputBlock) : outputBlock;
+    auto* data1 = filterBlock.getChannelPointer(0);
+    m_mixBuffer.copyFrom(0, 0, data1, numSamples << m_oversamplingOrder);
+    auto* data2 = m_mixBuffer.getWritePointer(0);
+
+    // Process both filters, updating the cutoff at control rate
+    for (auto startSample = 0; startSample < numSamples; startSample += MODULATION_RATE)
+    {
+        auto subBlockSize = juce::jmin(MODULATION_RATE, numSamples - startSample);
+        auto firstFiltered = startSample << m_oversamplingOrder;
+        auto numFiltered = subBlockSize << m_oversamplingOrder;
+        auto modulatedCutoff = computeModulatedCutoff(cutoffRatio[startSample],
+                envMod[startSample], vegSignal[startSample], aegSignal[startSample]);
+
+        m_open303Filter.setResonance(resonance[startSample] * open303ResonanceNoise, false);
+        m_open303Filter.setCutoff(modulatedCutoff * open303CutoffNoise, false);
+        m_open303Filter.calculateCoefficientsApprox4();
+        m_open303Filter.processBlock(data1 + firstFiltered, numFiltered);
+
+        m_oberheimFilter.setResonance(resonance[startSample] * oberheimResonanceNoise);
+        m_oberheimFilter.setCutoff(modulatedCutoff * oberheimCutoffNoise);
+        m_oberheimFilter.process(data2 + firstFiltered, numFiltered);
+
+        // Apply general gain + custom gain reduction when resonance is high to
+        // force the two filters on a same level range
+        auto customGain = juce::Decibels::decibelsToGain<float>(OBERHEIM_GAIN_REDUCTION
+                * resonanceRatio[startSample]);
+
+        // Mix the two filters outputs, the mix ramp is held during the
+        // oversampled samples
+        for (auto i = startSample; i < startSample + subBlockSize; ++i)
+        {
+            auto open303Gain = mixRatio[i];
+            auto oberheimGain = customGain * (1.f - mixRatio[i]);
+
+            for (auto j = i << m_oversamplingOrder; j < (i + 1) << m_oversamplingOrder; ++j)
+            {
+                data1[j] = data1[j] * open303Gain + data2[j] * oberheimGain;
+            }
+        }
+    }
 
+    if (m_oversampling != nullptr)
+    {
+        m_oversampling->processSamplesDown(outputBlock);
+    }
+}
 
-    megValue = r_signalBus.readSignal(SignalBus::SignalId::VEG);
-    accent = r_signalBus.readSignal(SignalBus::SignalId::AEG);
-    jassert(megValue >= 0.);
-    jassert(accent >= 0.);
+float Filter::computeModulatedCutoff(float cutoffRatio, float envMod, 
+        float vegValue, float aegValue) const noexcept
+{
+    jassert(vegValue >= 0.);
+    jassert(aegValue >= 0.);
 
     // Compute the mod ratio
-    auto envModRatio = (megValue * m_envMod.getCurrentValue() * ENV_MOD_RATIO_AMMOUNT);
+    auto envModRatio = (vegValue * envMod * ENV_MOD_RATIO_AMMOUNT);
 
     // Compute the accent ratio
-    auto accentRatio = (accent * ACCENT_RATIO_AMMOUNT);
+    auto accentRatio = (aegValue * ACCENT_RATIO_AMMOUNT);
 
-    auto cutoffRatio = m_cutoffFreq.getUnscaledRatioForCurrentValue()
-            + envModRatio + accentRatio;
+    auto modulatedRatio = cutoffRatio + envModRatio + accentRatio;
 
-    float modulatedCutoff;
-    if (cutoffRatio > 1.0)
+    if (modulatedRatio > 1.0)
     {
         // Custom compute to allow accent note to go higher than the max of
         // the cutoff parameter
-        auto pow = cutoffRatio * cutoffRatio;
-        modulatedCutoff = pow * m_cutoffFreq.getScaledValueForUnscaledRatio(1.0);
-    }
-    else
-    {
-        modulatedCutoff = m_cutoffFreq.getScaledValueForUnscaledRatio(cutoffRatio);
+        auto pow = modulatedRatio * modulatedRatio;
+        return pow * m_maxCutoff;
     }
 
-    // Update of both the filters
-    m_oberheimFilter->SetCutoff(modulatedCutoff * r_noiseGenerator.getNoiseFactor());
-    m_oberheimFilter->SetResonance(m_resonance.getCurrentValue() * r_noiseGenerator.getNoiseFactor());
-    m_open303Filter.setCutoff(modulatedCutoff * r_noiseGenerator.getNoiseFactor());
-    m_open303Filter.setResonance(m_resonance.getCurrentValue() * r_noiseGenerator.getNoiseFactor() * 100 / m_resonance.getScaledValueForUnscaledRatio(1.f));
-
-    // Prepare audio buffers for processing    
-    auto outputBlock = context.getOutputBlock();
-    auto* data1 = outputBlock.getChannelPointer(0);
-    m_mixBuffer.copyFrom(0, 0, data1, outputBlock.getNumSamples());
-    auto* data2 = m_mixBuffer.getWritePointer(0);
-    auto mixRatio = m_filtersMix.getCurrentValue();
-
-    // Process with Open303 filter
-    for (auto i = 0; i < outputBlock.getNumSamples(); ++i)
-    {
-        // Directly applying the mix gain
-        *data1 = mixRatio * m_open303Filter.getSample(*data1);
-        ++data1;
-    }
-
-    // Process with Oberheim filter
-    m_oberheimFilter->Process(data2, outputBlock.getNumSamples());
-    // Apply general gain + custom gain reduction when resonance is high to
-    // force the two filters on a same level range
-    auto customGain = juce::Decibels::decibelsToGain<float>(OBERHEIM_GAIN_REDUCTION
-            * m_resonance.getUnscaledRatioForCurrentValue());
-    m_mixBuffer.applyGain(customGain * (1.0 - mixRatio));
-
-    // Mix the two filters outputs
-    outputBlock.add(juce::dsp::AudioBlock<float>(m_mixBuffer));
+    return m_cutoffFreq.getScaledValueForUnscaledRatio(modulatedRatio);
 }
 
 } // namespace engine
@@ -12,9 +12,10 @@
 
 #include <JuceHeader.h>
 
-#include "Engine/Filter/MoogLadders/OberheimVariationModel.h"
+#include "Engine/Filter/OberheimLadder.h"
 #include "Engine/Filter/Open303/rosic_TeeBeeFilter.h"
 #include "Engine/Binding.h"
+#include "Engine/ParameterRamp.h"
 
 namespace engine
 {
@@ -28,12 +29,27 @@ namespace engine
  * 
  * Holds an instance of the filter and keeps track of the different
  * parameters. This is where the accent's and envelope modulations of the
- * filter's cutoff are computed
+ * filter's cutoff are computed, from the per sample modulation signals of the
+ * SignalBus, every few samples
+ *
+ * The parameters are smoothed from the engine snapshot, so a sweep does not
+ * step through their discrete values. The cutoff parameter itself is only
+ * kept for its precomputed scale, to map the modulated ratio back to a
+ * frequency
+ *
+ * The saturation of both filters aliases, so they can run oversampled : the
+ * block is upsampled by a polyphase half-band IIR, filtered and mixed at the
+ * high rate, then downsampled. The rest of the engine stays at the device
+ * rate, and the modulation signals are held during the oversampled samples.
  */
 class Filter
 {
 public:
-    Filter(Bindings bindings);
+    /**
+     * @param bindings           The bindings to the engine
+     * @param oversamplingFactor The oversampling of the filters, 1, 2 or 4
+     */
+    Filter(Bindings bindings, int oversamplingFactor = 1);
     ~Filter() {};
 
 //==============================================================================
@@ -48,18 +64,37 @@ public:
      */
     void process(juce::dsp::ProcessContextReplacing<float>& context);
 
+    int getOversamplingFactor() const noexcept { return 1 << m_oversamplingOrder; }
+    /**
+     * @brief The latency added by the oversampling, in samples at the device
+     * rate
+     */
+    float getLatencyInSamples() const noexcept;
+
 private:
+    /**
+     * @brief Compute the cutoff frequency for the given parameters and
+     * modulation values
+     */
+    float computeModulatedCutoff(float cutoffRatio, float envMod, 
+            float vegValue, float aegValue) const noexcept;
+
 //==============================================================================
-    std::unique_ptr<OberheimVariationMoog>      m_oberheimFilter;
+    OberheimLadder<float>                       m_oberheimFilter;
     rosic::TeeBeeFilter                         m_open303Filter;
-    NoiseGenerator&                             r_noiseGenerator;
+    NoiseGenerator                              m_noiseGenerator;
     SignalBus&                                  r_signalBus;
+    ParameterRamp                               m_cutoffRatio;
+    ParameterRamp                               m_resonance;
+    ParameterRamp                               m_resonanceRatio;
+    ParameterRamp                               m_envMod;
+    ParameterRamp                               m_filtersMix;
     juce::AudioBuffer<float>                    m_mixBuffer;
+    std::unique_ptr<juce::dsp::Oversampling<float>> m_oversampling;
+    int                                         m_oversamplingOrder;
     control::ControllableParameter              m_cutoffFreq;
-    control::ControllableParameter              m_resonance;
-    control::ControllableParameter              m_drive;
-    control::ControllableParameter              m_envMod;
-    control::ControllableParameter              m_filtersMix;
+    float                                       m_maxCutoff;
+    float                                       m_maxResonance;
 };
 
 } // namespace engine
@@ -1,64 +0,0 @@
-/**
-*   This file was downloaded from this repository containing many
-*   different Moogs filter implementations.
-*   
-*   https://github.com/ddiakopoulos/MoogLadders
-* 
-*   The project is licensed under the The Unlicense :
-
-This is free and unencumbered software released into the public domain.
-
-Anyone is free to copy, modify, publish, use, compile, sell, or
-distribute this software, either in source code form or as a compiled
-binary, for any purpose, commercial or non-commercial, and by any
-means.
-
-In jurisdictions that recognize copyright laws, the author or authors
-of this software dedicate any and all copyright interest in the
-software to the public domain. We make this dedication for the benefit
-of the public at large and to the detriment of our heirs and
-successors. We intend this dedication to be an overt act of
-relinquishment in perpetuity of all present and future rights to this
-software under copyright law.
-
-THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
-EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
-MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
-IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
-OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
-ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
-OTHER DEALINGS IN THE SOFTWARE.
-
-For more information, please refer to <http://unlicense.org/>
-
-*/
-
-#pragma once
-
-#ifndef LADDER_FILTER_BASE_H
-#define LADDER_FILTER_BASE_H
-
-#include "Util.h"
-
-class LadderFilterBase
-{
-public:
-	
-	LadderFilterBase(float sampleRate) : sampleRate(sampleRate) {}
-	virtual ~LadderFilterBase() {}
-	
-	virtual void Process(float * samples, uint32_t n) = 0;
-	virtual void SetResonance(float r) = 0;
-	virtual void SetCutoff(float c) = 0;
-	
-	float GetResonance() { return resonance; }
-	float GetCutoff() { return cutoff; }
-	
-protected:
-	
-	float cutoff;
-	float resonance;
-	float sampleRate;
-};
-
-#endif
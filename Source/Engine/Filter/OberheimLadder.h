@@ -0,0 +1,165 @@
+/*
+  ==============================================================================
+
+    OberheimLadder.h
+    Created: 17 Oct 2026 6:12:55pm
+    Author:  maxime
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <cmath>
+
+#include <JuceHeader.h>
+
+namespace engine
+{
+
+/**
+ * @class engine::OberheimLadder
+ * @brief A virtual analog model of the Oberheim variation of the Moog ladder
+ * filter, in its 24dB/octave lowpass configuration
+ *
+ * Based on OberheimVariationMoog from
+ * https://github.com/ddiakopoulos/MoogLadders (Unlicense), itself based on
+ * the Will Pirkle's model.
+ *
+ * This is a value type : the four one pole stages are stored inline and
+ * processed without any indirection, and neither prepare() nor reset()
+ * allocates. The input saturation uses a clamped rational approximation of
+ * tanh instead of std::tanh.
+ *
+ * @tparam SampleType float or double
+ */
+template <typename SampleType>
+class OberheimLadder
+{
+public:
+    static constexpr int NUM_STAGES = 4;
+
+    OberheimLadder() noexcept
+    {
+        setCutoff(SampleType(1000));
+        setResonance(SampleType(0.1));
+        reset();
+    }
+
+//==============================================================================
+    /**
+     * @brief Set the sample rate and recompute the coefficients, does not
+     * allocate
+     */
+    void prepare(SampleType sampleRate) noexcept
+    {
+        jassert(sampleRate > 0);
+        m_sampleRate = sampleRate;
+        updateCoefficients();
+        reset();
+    }
+
+    /**
+     * @brief Clear the state of the stages
+     */
+    void reset() noexcept
+    {
+        m_state.fill(SampleType(0));
+    }
+
+    /**
+     * @brief Set the cutoff frequency in Hz
+     */
+    void setCutoff(SampleType cutoff) noexcept
+    {
+        if (cutoff != m_cutoff)
+        {
+            m_cutoff = cutoff;
+            updateCoefficients();
+        }
+    }
+
+    /**
+     * @brief Set the resonance, mapped from [1;10] to a feedback of [0;4]
+     */
+    void setResonance(SampleType resonance) noexcept
+    {
+        m_feedback = SampleType(4) * (resonance - SampleType(1)) / SampleType(9);
+        m_alpha0 = SampleType(1) / (SampleType(1) + m_feedback * m_gamma);
+    }
+
+    void setSaturation(SampleType saturation) noexcept { m_saturation = saturation; }
+
+//==============================================================================
+    /**
+     * @brief Filter a block of samples in place
+     */
+    void process(SampleType* samples, int numSamples) noexcept
+    {
+        // Local copies, so the whole state stays in registers
+        auto z = m_state;
+        auto feedback = m_feedback;
+        auto inputGain = SampleType(1) + m_feedback;
+        auto preGain = m_alpha0 * m_saturation;
+        auto G = m_G;
+
+        for (auto i = 0; i < numSamples; ++i)
+        {
+            auto sigma = m_beta[0] * z[0] + m_beta[1] * z[1]
+                    + m_beta[2] * z[2] + m_beta[3] * z[3];
+            auto u = fastTanh((samples[i] * inputGain - feedback * sigma) * preGain);
+
+            for (auto stage = 0; stage < NUM_STAGES; ++stage)
+            {
+                // Trapezoidal integrator
+                auto vn = (u - z[stage]) * G;
+                u = vn + z[stage];
+                z[stage] = vn + u;
+            }
+
+            samples[i] = u;
+        }
+
+        m_state = z;
+    }
+
+    /**
+     * @brief Rational approximation of tanh, clamped so it saturates at +-1
+     */
+    static forcedinline SampleType fastTanh(SampleType x) noexcept
+    {
+        x = juce::jlimit(SampleType(-3), SampleType(3), x);
+        auto x2 = x * x;
+        return x * (SampleType(27) + x2) / (SampleType(27) + SampleType(9) * x2);
+    }
+
+private:
+    void updateCoefficients() noexcept
+    {
+        // Prewarp for the bilinear transform
+        auto g = std::tan(juce::MathConstants<SampleType>::pi * m_cutoff / m_sampleRate);
+        auto oneOverOnePlusG = SampleType(1) / (SampleType(1) + g);
+
+        m_G = g * oneOverOnePlusG;
+        m_beta[0] = m_G * m_G * m_G * oneOverOnePlusG;
+        m_beta[1] = m_G * m_G * oneOverOnePlusG;
+        m_beta[2] = m_G * oneOverOnePlusG;
+        m_beta[3] = oneOverOnePlusG;
+        m_gamma = m_G * m_G * m_G * m_G;
+        m_alpha0 = SampleType(1) / (SampleType(1) + m_feedback * m_gamma);
+    }
+
+//==============================================================================
+    std::array<SampleType, NUM_STAGES>      m_state {};
+    std::array<SampleType, NUM_STAGES>      m_beta {};
+    SampleType                              m_G = 0;
+    SampleType                              m_gamma = 0;
+    SampleType                              m_alpha0 = 1;
+    SampleType                              m_feedback = 0;
+    SampleType                              m_saturation = 1;
+    SampleType                              m_cutoff = 0;
+    SampleType                              m_sampleRate = 44100;
+};
+
+} // namespace engine
@@ -98,6 +98,13 @@ namespace rosic
     /** Returns the cutoff-frequency. */
     double getCutoff() const { return cutoff; }
 
+    /** Returns the filter coefficients, to run the filter inlined in a block loop. */
+    void getCoefficients(double *outB0, double *outB1, double *outA1) const
+    { *outB0 = b0; *outB1 = b1; *outA1 = a1; }
+
+    /** Returns the internal state variables, to run the filter inlined in a block loop. */
+    void getInternalState(double *outX1, double *outY1) const { *outX1 = x1; *outY1 = y1; }
+
     //---------------------------------------------------------------------------------------------
     // audio processing:
 
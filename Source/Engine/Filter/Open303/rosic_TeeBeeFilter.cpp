@@ -101,6 +101,93 @@ void TeeBeeFilter::setMode(int newMode)
   calculateCoefficientsApprox4();
 }
 
+//-------------------------------------------------------------------------------------------------
+// audio processing:
+
+void TeeBeeFilter::processBlock(float *samples, int numSamples)
+{
+  // the feedback highpass is run inline, its state is written back at the end:
+  double hpB0, hpB1, hpA1, hpX1, hpY1;
+  feedbackHighpass.getCoefficients(&hpB0, &hpB1, &hpA1);
+  feedbackHighpass.getInternalState(&hpX1, &hpY1);
+
+  const float fhpB0 = (float) hpB0;
+  const float fhpB1 = (float) hpB1;
+  const float fhpA1 = (float) hpA1;
+  const float fk    = (float) k;
+  float fhpX1 = (float) hpX1;
+  float fhpY1 = (float) hpY1;
+  float fy1   = (float) y1;
+  float fy2   = (float) y2;
+  float fy3   = (float) y3;
+  float fy4   = (float) y4;
+
+  if( mode == TB_303 )
+  {
+    const float fb0      = (float) b0;
+    const float f2b0     = (float) (2*b0);
+    const float fOutGain = (float) (2*g);
+    const float fkr6     = fk * (1.f/6.f);
+    const float clipMax  = (float) SQRT2;
+
+    // the loop is a single chain of dependencies from y4 to y4, so every term that does not
+    // depend on the previous step of the chain is computed aside to shorten it
+    for(int n = 0; n < numSamples; n++)
+    {
+      float s1 = fy1 + f2b0*(fy2-fy1);
+      float s2 = fy2 + fb0*(fy3-2*fy2);
+      float s3 = fy3 + fb0*(fy4-2*fy3);
+      float s4 = fy4 - fb0*2*fy4;
+      float hp = fhpB1*fhpX1 + fhpA1*fhpY1 + TINY;
+
+      // k*shape(y4), the clipping compiles to min/max instructions:
+      float x  = fy4 < -clipMax ? -clipMax : (fy4 > clipMax ? clipMax : fy4);
+      float fb = x * (fk - fkr6*x*x);
+
+      // feedbackHighpass.getSample(fb):
+      fhpY1 = fhpB0*fb + hp;
+      fhpX1 = fb;
+
+      float y0 = samples[n] - fhpY1;
+      fy1 = s1 + f2b0*y0;
+      fy2 = s2 + fb0*fy1;
+      fy3 = s3 + fb0*fy2;
+      fy4 = s4 + fb0*fy3;
+      samples[n] = fOutGain*fy4;
+    }
+  }
+  else
+  {
+    const float fa1      = (float) a1;
+    const float fInGain  = (float) (0.125*driveFactor);
+    const float fc0      = (float) (8.0*c0);
+    const float fc1      = (float) (8.0*c1);
+    const float fc2      = (float) (8.0*c2);
+    const float fc3      = (float) (8.0*c3);
+    const float fc4      = (float) (8.0*c4);
+
+    for(int n = 0; n < numSamples; n++)
+    {
+      float fb = fk * fy4;
+      fhpY1 = fhpB0*fb + fhpB1*fhpX1 + fhpA1*fhpY1 + TINY;
+      fhpX1 = fb;
+
+      float y0 = fInGain*samples[n] - fhpY1;
+      fy1 = y0  + fa1*(y0-fy1);
+      fy2 = fy1 + fa1*(fy1-fy2);
+      fy3 = fy2 + fa1*(fy2-fy3);
+      fy4 = fy3 + fa1*(fy3-fy4);
+      samples[n] = fc0*y0 + fc1*fy1 + fc2*fy2 + fc3*fy3 + fc4*fy4;
+    }
+  }
+
+  feedbackHighpass.setInternalState(fhpX1, fhpY1);
+  y1 = fy1;
+  y2 = fy2;
+  y3 = fy3;
+  y4 = fy4;
+}
+
 //-------------------------------------------------------------------------------------------------
 // others:
 
@@ -132,6 +132,11 @@ namespace rosic
     /** Calculates one output sample at a time. */
     INLINE double getSample(double in);
 
+    /** Processes a block of samples in place, in single precision. The mode branch is hoisted
+    out of the loop and the feedback highpass is inlined, so the whole state lives in registers.
+    The output matches getSample() up to the float rounding. */
+    void processBlock(float *samples, int numSamples);
+
     //---------------------------------------------------------------------------------------------
     // others:
 
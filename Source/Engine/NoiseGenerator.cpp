@@ -10,17 +10,82 @@
 
 #include "NoiseGenerator.h"
 
+#include <random>
+
 namespace engine
 {
 
-NoiseGenerator::NoiseGenerator(float range)
+NoiseGenerator::NoiseGenerator(float range, juce::uint64 seed)
+    : m_state(),
+      m_lanes(),
+      m_seed(seed),
+      m_offset(1.f - range),
+      m_scale(2.f * range)
+{
+    while (m_seed == RANDOM_SEED)
+    {
+        auto randomDevice = std::random_device();
+        m_seed = (juce::uint64(randomDevice()) << 32) | randomDevice();
+    }
+
+    seedState(m_seed);
+}
+
+NoiseGenerator NoiseGenerator::fork(juce::uint32 streamId) const noexcept
+{
+    // Mix the stream id into the seed, so close ids give unrelated streams
+    auto state = m_seed ^ (juce::uint64(streamId) << 32 | streamId);
+    auto streamSeed = splitMix(state);
+
+    return NoiseGenerator(m_scale * 0.5f,
+            streamSeed == RANDOM_SEED ? streamSeed + 1 : streamSeed);
+}
+
+void NoiseGenerator::fillNoiseFactors(float* destination, int numSamples) noexcept
+{
+    auto i = 0;
+
+    // The lanes are independent, so this inner loop is vectorised
+    for (; i + NUM_LANES <= numSamples; i += NUM_LANES)
+    {
+        for (auto lane = 0; lane < NUM_LANES; ++lane)
+        {
+            auto random = nextRandom(m_lanes[0][lane], m_lanes[1][lane],
+                    m_lanes[2][lane], m_lanes[3][lane]);
+            destination[i + lane] = toNoiseFactor(random);
+        }
+    }
+
+    for (; i < numSamples; ++i)
+    {
+        destination[i] = getNoiseFactor();
+    }
+}
+
+void NoiseGenerator::seedState(juce::uint64 seed) noexcept
+{
+    // Every state word is initialised with splitmix64, as recommended by the
+    // xoshiro authors
+    for (auto& word : m_state)
+    {
+        word = juce::uint32(splitMix(seed) >> 32);
+    }
+
+    for (auto lane = 0; lane < NUM_LANES; ++lane)
+    {
+        for (auto& word : m_lanes)
+        {
+            word[lane] = juce::uint32(splitMix(seed) >> 32);
+        }
+    }
+}
+
+juce::uint64 NoiseGenerator::splitMix(juce::uint64& state) noexcept
 {
-    auto randomDevice = std::random_device();
-    m_generator.seed(randomDevice());
-    m_distrib.param(std::uniform_real_distribution<float>::param_type(
-        1. - range,
-        1. + range
-    ));
+    auto z = (state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
 }
 
 } // namespace engine
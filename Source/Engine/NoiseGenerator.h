@@ -10,7 +10,8 @@
 
 #pragma once
 
-#include <random>
+#include <array>
+#include <cmath>
 
 #include <JuceHeader.h>
 
@@ -23,22 +24,63 @@ namespace engine
  * to the sound.
  * 
  * One instance should be shared among the whole engine. Call getNoiseFactor() 
- * to get a factor around 1.f to multiply your signal with.
+ * to get a factor around 1.f to multiply your signal with, or 
+ * fillNoiseFactors() to get one factor per sample of a block.
  * 
  * This noise generator is based on a uniform distribution among 
- * [1.0 - range: 1.0 + range]
+ * [1.0 - range: 1.0 + range], drawn from xoshiro128+ generators. The block
+ * API runs NUM_LANES independent generators side by side, which the compiler
+ * vectorises.
+ * 
+ * The same seed always produces the same noise. Modules should not draw from
+ * the shared instance directly, but from their own stream created with fork(),
+ * so their noise does not depend on what the other modules draw.
  */
 class NoiseGenerator
 {
 public:
+    static constexpr int NUM_LANES = 4;
+    /**
+     * @brief Use this seed to get a random one from std::random_device
+     */
+    static constexpr juce::uint64 RANDOM_SEED = 0;
+
+    /**
+     * @brief The ids of the modules noise streams, see fork()
+     */
+    enum StreamId : juce::uint32
+    {
+        OSCILLATOR_1 = 0,
+        OSCILLATOR_2,
+        DUAL_OSCILLATOR,
+        FILTER,
+        VOICE_POOL,
+        UNISON_STACK
+    };
+
     /**
      * @brief Construct a new Noise Generator object
      * 
      * @param range The float range to vary around 1.f. Be careful when using
      * values higher than 0.05, it tends to produce a really audible and instable
      * effect.
+     * @param seed The seed of the generator, or RANDOM_SEED
+     */
+    NoiseGenerator(float range, juce::uint64 seed = RANDOM_SEED);
+
+    /**
+     * @brief Create a new generator with the same range, which stream only
+     * depends on the seed of this one and on the stream id
+     * 
+     * The noise already drawn from this generator has no effect on the fork.
+     */
+    NoiseGenerator fork(juce::uint32 streamId) const noexcept;
+
+    /**
+     * @brief The seed actually used, even when built with RANDOM_SEED, so a
+     * random run can be replayed
      */
-    NoiseGenerator(float range);
+    juce::uint64 getSeed() const noexcept { return m_seed; }
 
     /**
      * @brief Compute a random factor around 1.f to multiply your signal with to
@@ -46,12 +88,99 @@ public:
      */
     forcedinline float getNoiseFactor() noexcept
     {
-        return m_distrib(m_generator);
+        return toNoiseFactor(nextRandom(m_state[0], m_state[1], m_state[2], m_state[3]));
+    }
+
+    /**
+     * @brief Fill a buffer with random factors around 1.f, one per sample
+     * 
+     * @param destination The buffer to fill
+     * @param numSamples  The number of factors to write
+     */
+    void fillNoiseFactors(float* destination, int numSamples) noexcept;
+
+private:
+    void seedState(juce::uint64 seed) noexcept;
+    static juce::uint64 splitMix(juce::uint64& state) noexcept;
+
+    /**
+     * @brief One step of xoshiro128+, see https://prng.di.unimi.it
+     */
+    static forcedinline juce::uint32 nextRandom(juce::uint32& s0, juce::uint32& s1,
+            juce::uint32& s2, juce::uint32& s3) noexcept
+    {
+        auto result = s0 + s3;
+        auto t = s1 << 9;
+
+        s2 ^= s0;
+        s3 ^= s1;
+        s1 ^= s2;
+        s0 ^= s3;
+        s2 ^= t;
+        s3 = (s3 << 11) | (s3 >> 21);
+
+        return result;
+    }
+
+    forcedinline float toNoiseFactor(juce::uint32 random) const noexcept
+    {
+        // The 24 upper bits are the best ones, and exactly fit a float : the
+        // uniform value is exact, within [0; 1[. The factor is rounded, so it
+        // can reach both bounds of the range
+        auto uniform = float(random >> 8) * (1.f / 16777216.f);
+        return m_offset + m_scale * uniform;
+    }
+
+//==============================================================================
+    std::array<juce::uint32, 4>                                 m_state;
+    // The lanes states, stored as [state word][lane] to be vectorised
+    alignas(16) std::array<std::array<juce::uint32, NUM_LANES>, 4>  m_lanes;
+    juce::uint64                                                m_seed;
+    float                                                       m_offset;
+    float                                                       m_scale;
+};
+
+//==============================================================================
+/**
+ * @class engine::NoiseDrift
+ * @brief A slowly moving factor around 1.f, meant to be drawn once per control
+ * block instead of once per sample
+ * 
+ * The noise factors are smoothed by a one pole lowpass filter, which keeps
+ * the drift band-limited : the value moves smoothly from one block to the
+ * next, within a narrower range than the generator.
+ */
+class NoiseDrift
+{
+public:
+    NoiseDrift() = default;
+
+    /**
+     * @brief Set the cutoff of the smoothing filter
+     * 
+     * @param controlRate The number of values drawn per second
+     * @param cutoff      The cutoff frequency in Hz
+     */
+    void prepare(double controlRate, double cutoff) noexcept
+    {
+        jassert(controlRate > 0. && cutoff > 0.);
+        m_coeff = float(1. - std::exp(- juce::MathConstants<double>::twoPi * cutoff / controlRate));
+    }
+
+    void reset() noexcept { m_value = 1.f; }
+
+    /**
+     * @brief Draw the next drift factor
+     */
+    forcedinline float getNextDriftFactor(NoiseGenerator& generator) noexcept
+    {
+        m_value += m_coeff * (generator.getNoiseFactor() - m_value);
+        return m_value;
     }
 
 private:
-    std::mt19937                            m_generator;
-    std::uniform_real_distribution<float>   m_distrib;
+    float                                   m_value = 1.f;
+    float                                   m_coeff = 1.f;
 };
 
 } // namespace engine
\ No newline at end of file
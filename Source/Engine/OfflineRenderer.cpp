@@ -0,0 +1,159 @@
+/*
+  ==============================================================================
+
+    OfflineRenderer.cpp
+    Created: 17 Oct 2026 10:12:03am
+    Author:  maxime
+
+  ==============================================================================
+*/
+
+#include "OfflineRenderer.h"
+
+#include <iostream>
+
+namespace engine
+{
+
+// Time rendered after the last midi event, to let the envelopes release
+constexpr double RENDER_TAIL_S = 1.0;
+constexpr int    RENDER_NUM_CHANNELS = 2;
+constexpr int    RENDER_BIT_DEPTH = 24;
+
+//==============================================================================
+double OfflineRenderer::Report::getRealTimeFactor() const noexcept
+{
+    if (m_callbackSeconds > 0.)
+    {
+        return m_renderedSeconds / m_callbackSeconds;
+    }
+
+    return 0.;
+}
+
+//==============================================================================
+OfflineRenderer::OfflineRenderer(RaciderryEngine& engine, control::MidiBroker& midiBroker)
+    : r_engine(engine),
+      r_midiBroker(midiBroker)
+{
+    // Nothing to do here
+}
+
+//==============================================================================
+OfflineRenderer::Report OfflineRenderer::render(
+        const juce::MidiMessageSequence& sequence,
+        juce::AudioBuffer<float>& output,
+        double sampleRate,
+        int blockSize)
+{
+    jassert(sampleRate > 0.);
+    jassert(blockSize > 0);
+
+    auto report = Report();
+    auto totalSamples = int(std::ceil((sequence.getEndTime() + RENDER_TAIL_S) * sampleRate));
+    auto numEvents = sequence.getNumEvents();
+    auto eventIndex = 0;
+
+    output.setSize(RENDER_NUM_CHANNELS, totalSamples);
+    output.clear();
+    r_engine.prepare(sampleRate, blockSize);
+
+    for (auto startSample = 0; startSample < totalSamples; startSample += blockSize)
+    {
+        auto numSamples = juce::jmin(blockSize, totalSamples - startSample);
+        auto blockEndTime = (startSample + numSamples) / sampleRate;
+
+        // Send the midi events of this block to the broker, like the midi
+        // thread would do
+        while (eventIndex < numEvents
+                && sequence.getEventPointer(eventIndex)->message.getTimeStamp() < blockEndTime)
+        {
+            auto msg = sequence.getEventPointer(eventIndex++)->message;
+
+            if (msg.getChannel() == 0)
+            {
+                // Meta events, sysex...
+                continue;
+            }
+
+            msg.setChannel(r_midiBroker.getMidiChannel());
+            r_midiBroker.handleIncomingMidiMessage(nullptr, msg);
+        }
+
+        // Only the audio callback is measured
+        float* channels[RENDER_NUM_CHANNELS] = {
+            output.getWritePointer(0, startSample),
+            output.getWritePointer(1, startSample)
+        };
+        auto startTicks = juce::Time::getHighResolutionTicks();
+        r_engine.renderNextBlock(channels, numSamples, blockEndTime);
+        auto endTicks = juce::Time::getHighResolutionTicks();
+
+        report.m_callbackSeconds += juce::Time::highResolutionTicksToSeconds(endTicks - startTicks);
+        report.m_numBlocks++;
+    }
+
+    r_engine.reset();
+    report.m_renderedSeconds = totalSamples / sampleRate;
+
+    return report;
+}
+
+int OfflineRenderer::renderFile(const juce::File& midiFile, const juce::File& wavFile,
+        double sampleRate, int blockSize)
+{
+    // Read the midi file and merge all its tracks
+    auto midiStream = juce::FileInputStream(midiFile);
+    auto midi = juce::MidiFile();
+
+    if (midiStream.failedToOpen() || ! midi.readFrom(midiStream))
+    {
+        std::cerr << "Could not read midi file : " << midiFile.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    midi.convertTimestampTicksToSeconds();
+    auto sequence = juce::MidiMessageSequence();
+
+    for (auto track = 0; track < midi.getNumTracks(); ++track)
+    {
+        sequence.addSequence(*midi.getTrack(track), 0.);
+    }
+
+    // Render
+    auto output = juce::AudioBuffer<float>();
+    auto report = render(sequence, output, sampleRate, blockSize);
+
+    // Write the wav file
+    wavFile.deleteFile();
+    auto wavStream = std::make_unique<juce::FileOutputStream>(wavFile);
+    auto wavFormat = juce::WavAudioFormat();
+    auto writer = std::unique_ptr<juce::AudioFormatWriter>();
+
+    if (! wavStream->failedToOpen())
+    {
+        writer.reset(wavFormat.createWriterFor(wavStream.get(), sampleRate,
+                RENDER_NUM_CHANNELS, RENDER_BIT_DEPTH, {}, 0));
+    }
+
+    if (writer == nullptr)
+    {
+        std::cerr << "Could not write wav file : " << wavFile.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    // The writer now owns the stream
+    wavStream.release();
+    writer->writeFromAudioSampleBuffer(output, 0, output.getNumSamples());
+
+    std::cout << "Rendered " << report.m_renderedSeconds << "s of audio in "
+              << report.m_numBlocks << " blocks of " << blockSize << " samples at "
+              << sampleRate << "Hz" << std::endl;
+    std::cout << "Time spent in the audio callback : " << report.m_callbackSeconds
+              << "s (" << report.getRealTimeFactor() << "x real time)" << std::endl;
+    std::cout << r_engine.getProfiler().computeReport().toString() << std::flush;
+
+    return 0;
+}
+
+} // namespace engine
@@ -0,0 +1,86 @@
+/*
+  ==============================================================================
+
+    OfflineRenderer.h
+    Created: 17 Oct 2026 10:12:03am
+    Author:  maxime
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "Engine/Engine.h"
+#include "Control/MidiBroker.h"
+
+namespace engine
+{
+
+/**
+ * @class engine::OfflineRenderer
+ * @brief Runs the engine without any audio device, as fast as possible
+ *
+ * The renderer feeds a MIDI sequence to the MidiBroker block after block and
+ * calls RaciderryEngine::renderNextBlock() in a tight loop, exactly like the
+ * audio callback would do, with the sequence time as the callback time. Only
+ * the time spent inside the engine is measured, which gives the real-time
+ * factor of the engine on the current machine.
+ *
+ * Midi channel messages are remapped to the broker's channel, so any MIDI file
+ * can be rendered whatever its channels are.
+ */
+class OfflineRenderer
+{
+public:
+    /**
+     * @brief The timing results of a render
+     */
+    struct Report
+    {
+        double  m_renderedSeconds = 0.;     // Duration of the produced audio
+        double  m_callbackSeconds = 0.;     // Time spent in the audio callback
+        int     m_numBlocks = 0;            // Number of callbacks performed
+
+        /**
+         * @brief How many times faster than real time the engine ran
+         */
+        double getRealTimeFactor() const noexcept;
+    };
+
+//==============================================================================
+    OfflineRenderer(RaciderryEngine& engine, control::MidiBroker& midiBroker);
+
+//==============================================================================
+    /**
+     * @brief Render a midi sequence into a stereo buffer
+     *
+     * @param sequence   The midi sequence to play, timestamps in seconds
+     * @param output     The buffer to render into, resized by this method
+     * @param sampleRate The sample rate to run the engine at
+     * @param blockSize  The number of samples per callback
+     * @return Report    The timing of the render
+     */
+    Report render(const juce::MidiMessageSequence& sequence,
+            juce::AudioBuffer<float>& output, double sampleRate, int blockSize);
+
+    /**
+     * @brief Render a midi file into a wav file, and print the timing report
+     *
+     * @param midiFile   The midi file to read
+     * @param wavFile    The wav file to write, overwritten if it exists
+     * @param sampleRate The sample rate to run the engine at
+     * @param blockSize  The number of samples per callback
+     * @return int       0 on success, 1 otherwise. Can be used as an exit code
+     */
+    int renderFile(const juce::File& midiFile, const juce::File& wavFile,
+            double sampleRate, int blockSize);
+
+private:
+//==============================================================================
+    RaciderryEngine&                r_engine;
+    control::MidiBroker&            r_midiBroker;
+};
+
+} // namespace engine
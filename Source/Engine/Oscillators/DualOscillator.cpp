@@ -19,94 +19,134 @@ namespace engine
 
 constexpr double        WAFEFORM_GENERAL_GAIN = 0.5;
 
-DualOscillator::DualOscillator(Bindings bindings)
-    : m_wavetable1(),
-      m_wavetable2(),
-      m_wtOsc1(m_wavetable1, bindings),
-      m_wtOsc2(m_wavetable2, bindings),
-      r_noiseGenerator(bindings.r_noiseGenerator),
-      m_mixingBuffer(),
-      m_oscRatio()
+DualOscillator::DualOscillator(Bindings bindings, Kernel kernel)
+    : r_wavetables(bindings.r_wavetables),
+      m_wtOsc(),
+      m_polyBlepOsc(),
+      m_unisonStack(bindings, kernel == Kernel::analytic),
+      m_noiseGenerator(bindings.r_noiseGenerator.fork(NoiseGenerator::DUAL_OSCILLATOR)),
+      r_parameters(bindings.r_parameters),
+      m_oscRatio(bindings.r_parameters, control::ParameterSnapshot::WAVEFORM_RATIO),
+      m_kernel(kernel),
+      m_noteFrequency(440.0f),
+      m_mainPitchRatio(1.0f)
 {
-    // Load the wavetables in the buffers
-    utils::waveform::loadWavetableFromBinaryWaveFile(m_wavetable1, 
-            BinaryData::waveform_saw_wav, BinaryData::waveform_saw_wavSize);
-    utils::waveform::loadWavetableFromBinaryWaveFile(m_wavetable2,
-            BinaryData::waveform_square_wav, BinaryData::waveform_square_wavSize);
-
-    // Get the controllable parameters
-    auto parameterMap = bindings.m_parameterMap.lock();
-
-    m_oscRatio = (*parameterMap)[identifiers::controls::WAVEFORM_RATIO];
-    m_glide = (*parameterMap)[identifiers::controls::GLIDE];
-    jassert(m_oscRatio.isValid());
-    jassert(m_glide.isValid());
-
-    // Set osc glide
-    m_wtOsc1.setGlide(m_glide.getCurrentValue());
-    m_wtOsc2.setGlide(m_glide.getCurrentValue());
+    auto glide = r_parameters.getValue(control::ParameterSnapshot::GLIDE);
+
+    if (m_kernel == Kernel::analytic)
+    {
+        m_polyBlepOsc = std::make_unique<PolyBlepOscillator>(bindings,
+                NoiseGenerator::OSCILLATOR_1);
+        m_polyBlepOsc->setGlide(glide);
+    }
+    else
+    {
+        m_wtOsc = std::make_unique<WavetableOscillator>(r_wavetables.getFrame(0), bindings,
+                NoiseGenerator::OSCILLATOR_1);
+        m_wtOsc->setGlide(glide);
+    }
+
+    m_unisonStack.setGlide(glide);
 }
 
 //==============================================================================
 void DualOscillator::setFrequency(float newFrequency, bool force) noexcept
 {
-    m_wtOsc1.setFrequency(newFrequency, force);
-    m_wtOsc2.setFrequency(newFrequency, force);
+    m_noteFrequency = newFrequency;
+    setMainFrequency(force);
+    m_unisonStack.setFrequency(newFrequency, force);
 }
 
 void DualOscillator::prepare(float sampleRate, int blockSize) noexcept
 {
-    m_mixingBuffer.setSize(1, blockSize);
-    m_wtOsc1.prepare(sampleRate, blockSize);
-    m_wtOsc2.prepare(sampleRate, blockSize);
+    m_oscRatio.prepare(sampleRate, blockSize);
+
+    if (m_wtOsc != nullptr)
+    {
+        m_wtOsc->prepare(sampleRate, blockSize);
+    }
+    else
+    {
+        m_polyBlepOsc->prepare(sampleRate, blockSize);
+    }
+
+    m_unisonStack.prepare(sampleRate, blockSize);
 }
 
 void DualOscillator::reset() noexcept
 {
-    m_wtOsc1.reset();
-    m_wtOsc2.reset();
+    if (m_wtOsc != nullptr)
+    {
+        m_wtOsc->reset();
+    }
+    else
+    {
+        m_polyBlepOsc->reset();
+    }
+
+    m_unisonStack.reset();
+    m_oscRatio.reset();
 }
 
 void DualOscillator::process(juce::AudioBuffer<float>& outputBuffer, int startSample, 
         int numSamples) noexcept
 {
-    // Init
-    m_mixingBuffer.clear();
-    auto block = juce::dsp::AudioBlock<float>(
-        outputBuffer.getArrayOfWritePointers(),
-        outputBuffer.getNumChannels(),
-        startSample,
-        numSamples
-    );
-
-    // We get the controllable values for the whole block
-    auto glide = m_glide.getCurrentValue();
-    auto ratio = m_oscRatio.getCurrentValue() * r_noiseGenerator.getNoiseFactor();
-    m_wtOsc1.setGlide(glide * r_noiseGenerator.getNoiseFactor());
-    m_wtOsc2.setGlide(glide * r_noiseGenerator.getNoiseFactor());
-
-    // Process and apply gain for osc n°1
-    { 
-        auto context = juce::dsp::ProcessContextReplacing<float>(block);
-        m_wtOsc1.process(context);
+    // We get the controllable values for the whole block, the ratio is
+    // smoothed per sample
+    auto glide = r_parameters.getValue(control::ParameterSnapshot::GLIDE);
+    m_oscRatio.updateTarget(m_noiseGenerator.getNoiseFactor());
+    auto* ratio = m_oscRatio.getNextRamp(numSamples);
+    auto* output = outputBuffer.getWritePointer(0, startSample);
+
+    // The unison voices share the loudness of a single one
+    m_unisonStack.setVoices(
+            juce::roundToInt(r_parameters.getValue(control::ParameterSnapshot::UNISON_VOICES)),
+            r_parameters.getValue(control::ParameterSnapshot::UNISON_DETUNE),
+            r_parameters.getValue(control::ParameterSnapshot::SUB_LEVEL));
+    auto gain = float(WAFEFORM_GENERAL_GAIN);
+    auto mainGain = gain * m_unisonStack.getVoiceGain();
+
+    // An even number of voices moves the main one off the note
+    if (m_unisonStack.getMainPitchRatio() != m_mainPitchRatio)
+    {
+        m_mainPitchRatio = m_unisonStack.getMainPitchRatio();
+        setMainFrequency(false);
     }
-    outputBuffer.applyGain((1.0 - ratio) * WAFEFORM_GENERAL_GAIN);
-
-    // Process and apply gain for osc n° 2
-    block = juce::dsp::AudioBlock<float>(
-        m_mixingBuffer.getArrayOfWritePointers(),
-        m_mixingBuffer.getNumChannels(),
-        0,
-        numSamples
-    );
-    { 
-        auto context = juce::dsp::ProcessContextReplacing<float>(block);
-        m_wtOsc2.process(context);
+
+    glide *= m_noiseGenerator.getNoiseFactor();
+
+    if (m_kernel == Kernel::analytic)
+    {
+        m_polyBlepOsc->setGlide(glide);
+        m_polyBlepOsc->processMorph(ratio, mainGain, output, numSamples);
+    }
+    else
+    {
+        m_wtOsc->setGlide(glide);
+
+        // The ratio is the morph position through the frames, in a single pass
+        m_wtOsc->processMorph(r_wavetables, ratio, mainGain, output, numSamples,
+                m_kernel == Kernel::wavetableSIMD);
     }
-    outputBuffer.addFrom(0, startSample, m_mixingBuffer, 0, 0, numSamples, 
-            ratio * WAFEFORM_GENERAL_GAIN);
 
+    // The sub and the other voices of the unison are added on top
+    m_unisonStack.setGlide(glide);
+    m_unisonStack.process(r_wavetables, ratio, gain, output, numSamples);
 }
 
-} // namespace engine
+//==============================================================================
+void DualOscillator::setMainFrequency(bool force) noexcept
+{
+    auto frequency = m_noteFrequency * m_mainPitchRatio;
 
+    if (m_wtOsc != nullptr)
+    {
+        m_wtOsc->setFrequency(frequency, force);
+    }
+    else
+    {
+        m_polyBlepOsc->setFrequency(frequency, force);
+    }
+}
+
+} // namespace engine
@@ -13,28 +13,58 @@
 #include <JuceHeader.h>
 
 #include "Engine/Oscillators/WavetableOscillator.h"
+#include "Engine/Oscillators/PolyBlepOscillator.h"
+#include "Engine/Oscillators/UnisonStack.h"
 // #include "Engine/NoiseGenerator.h"
 #include "Engine/Binding.h"
+#include "Engine/ParameterRamp.h"
 
-#include "Control/ControllableParameter.h"
+#include "Control/ParameterSnapshot.h"
 
 namespace engine
 {
 
 /**
  * @class engine::DualOscillator
- * @brief A dual oscillator which mix ratio is controlled by the user
+ * @brief A morphing oscillator which position is controlled by the user
  * 
  * Based on the juce::dsp::Oscillator design.
  * 
- * Connected to the waveform ratio parameter, this produce a mix of two signals
- * A & B by computing ratio * A + (1 - ratio) * B. Signals are for now hardcoded
- * as saw and square signals
+ * Connected to the waveform ratio parameter, this morphs through the frames of
+ * the engine::WavetableBank of the engine, by mixing the two adjacent frames
+ * A & B matching the ratio. With the default bank, this is the mix of a saw
+ * and a square (1 - ratio) * saw + ratio * square.
+ *
+ * A single oscillator reads the two frames at the same phase and mixes them in
+ * one pass
+ *
+ * The analytic kernel replaces the wavetables with an engine::PolyBlepOscillator,
+ * the ratio then always mixes a saw and a square. Only the oscillator of the
+ * selected kernel is built, the analytic one never reads the bank
+ *
+ * The sub oscillator and the unison voices, set by the SUB_LEVEL,
+ * UNISON_VOICES and UNISON_DETUNE parameters, are rendered by an
+ * engine::UnisonStack on top of the main oscillator, which is itself detuned
+ * within the spread of an even number of voices
  */
 class DualOscillator
 {
 public:
-    DualOscillator(Bindings bindings);
+    /**
+     * @brief The ways to render the waveforms
+     */
+    enum class Kernel
+    {
+        wavetable,          // The frames of the wavetable bank
+        wavetableSIMD,      // Same, several samples per iteration when supported
+        analytic            // A polyBLEP saw and square, without any table
+    };
+
+    /**
+     * @param bindings The bindings to the engine
+     * @param kernel   The way to render the waveforms
+     */
+    DualOscillator(Bindings bindings, Kernel kernel = Kernel::wavetableSIMD);
 
 //==============================================================================
     /// juce::dsp::Oscillator like methods
@@ -44,16 +74,24 @@ public:
     void process(juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples) noexcept;
 
 private:
+    /**
+     * @brief Set the frequency of the main oscillator, from the note and its
+     * place in the unison
+     */
+    void setMainFrequency(bool force) noexcept;
+
 //==============================================================================
-    juce::AudioSampleBuffer                     m_wavetable1;
-    juce::AudioSampleBuffer                     m_wavetable2;
-    WavetableOscillator                         m_wtOsc1;
-    WavetableOscillator                         m_wtOsc2;
-    NoiseGenerator&                             r_noiseGenerator;
-    juce::AudioBuffer<float>                    m_mixingBuffer;
-    
-    control::ControllableParameter              m_oscRatio;
-    control::ControllableParameter              m_glide;
+    const WavetableBank&                        r_wavetables;
+    // Only the one matching the kernel is built
+    std::unique_ptr<WavetableOscillator>        m_wtOsc;
+    std::unique_ptr<PolyBlepOscillator>         m_polyBlepOsc;
+    UnisonStack                                 m_unisonStack;
+    NoiseGenerator                              m_noiseGenerator;
+    const control::ParameterSnapshot&           r_parameters;
+    ParameterRamp                               m_oscRatio;
+    Kernel                                      m_kernel;
+    float                                       m_noteFrequency;
+    float                                       m_mainPitchRatio;
 };
 
 } // namespace engine
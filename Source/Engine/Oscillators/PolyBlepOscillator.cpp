@@ -0,0 +1,136 @@
+/*
+  ==============================================================================
+
+    PolyBlepOscillator.cpp
+    Created: 18 Oct 2026 3:41:06am
+    Author:  maxime
+
+  ==============================================================================
+*/
+
+#include "PolyBlepOscillator.h"
+
+namespace engine
+{
+
+// Channels of the phases buffer
+enum PhaseChannel {PHASE, PHASE_DELTA, NUM_PHASE_CHANNELS};
+
+PolyBlepOscillator::PolyBlepOscillator(Bindings bindings, NoiseGenerator::StreamId noiseStream)
+    : m_noiseGenerator(bindings.r_noiseGenerator.fork(noiseStream)),
+      m_frequency(440.0f),
+      m_phase(0.0f),
+      m_phaseDelta(0.0f),
+      m_sampleRate(0.0f),
+      m_glide(0.0f),
+      m_noiseFactors(),
+      m_phases()
+{
+    // Nothing to do here
+}
+
+void PolyBlepOscillator::setFrequency(float newFreq, bool force) noexcept
+{
+    if (force || m_glide == 0.0)
+    {
+        m_frequency.setCurrentAndTargetValue(newFreq);
+
+        if (m_sampleRate > 0)
+        {
+            m_phaseDelta = m_frequency.getCurrentValue() / m_sampleRate;
+        }
+        return;
+    }
+
+    m_frequency.setTargetValue(newFreq);
+}
+
+void PolyBlepOscillator::prepare(float sampleRate, int blockSize) noexcept
+{
+    m_phase = 0.0f;
+    m_sampleRate = sampleRate;
+    m_phaseDelta = m_frequency.getCurrentValue() / m_sampleRate;
+    m_frequency.reset(m_sampleRate, m_glide);
+    m_noiseFactors.setSize(1, blockSize);
+    m_phases.setSize(NUM_PHASE_CHANNELS, blockSize);
+}
+
+void PolyBlepOscillator::reset() noexcept
+{
+    m_sampleRate = 0.0;
+}
+
+void PolyBlepOscillator::processMorph(const float* ratio, float gain, float* output,
+        int numSamples) noexcept
+{
+    jassert(numSamples <= m_phases.getNumSamples());
+
+    auto* noise = m_noiseFactors.getWritePointer(0);
+    auto* phases = m_phases.getWritePointer(PHASE);
+    auto* phaseDeltas = m_phases.getWritePointer(PHASE_DELTA);
+    m_noiseGenerator.fillNoiseFactors(noise, numSamples);
+
+    // The phase depends on the previous sample, it is accumulated first
+    for (auto i = 0; i < numSamples; ++i)
+    {
+        if (m_frequency.isSmoothing())
+        {
+            m_phaseDelta = m_frequency.getNextValue() / m_sampleRate;
+        }
+
+        auto phaseDelta = m_phaseDelta * noise[i];
+        phases[i] = m_phase;
+        phaseDeltas[i] = phaseDelta;
+
+        m_phase += phaseDelta;
+
+        if (m_phase >= 1.f)
+        {
+            m_phase -= 1.f;
+        }
+    }
+
+    // The waveforms only depend on the phase, this loop is vectorised
+    for (auto i = 0; i < numSamples; ++i)
+    {
+        auto phase = phases[i];
+        auto phaseDelta = phaseDeltas[i];
+        auto halfPhase = phase < 0.5f ? phase + 0.5f : phase - 0.5f;
+
+        // The saw falls at the phase 0, the square at the phase 0.5
+        auto saw = 2.f * phase - 1.f - polyBlep(phase, phaseDelta);
+        auto square = (phase < 0.5f ? 1.f : -1.f) + polyBlep(phase, phaseDelta)
+                - polyBlep(halfPhase, phaseDelta);
+
+        output[i] = gain * (saw + ratio[i] * (square - saw));
+    }
+}
+
+void PolyBlepOscillator::setGlide(float glideTime) noexcept
+{
+    jassert(glideTime >= 0.0);
+
+    if (glideTime == m_glide)
+    {
+        return;
+    }
+
+    m_glide = glideTime;
+
+    if (!(m_sampleRate > 0))
+    {
+        // If the samplerate is not set, no need to update the smoothedFreq
+        return;
+    }
+
+    if (glideTime > 0.)
+    {
+        m_frequency.update(m_sampleRate, glideTime);
+    }
+    else if (glideTime == 0.)
+    {
+        m_frequency.skipRamp();
+    }
+}
+
+} // namespace engine
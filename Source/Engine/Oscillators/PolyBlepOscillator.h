@@ -0,0 +1,101 @@
+/*
+  ==============================================================================
+
+    PolyBlepOscillator.h
+    Created: 18 Oct 2026 3:41:06am
+    Author:  maxime
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "Engine/Binding.h"
+#include "Engine/Oscillators/WavetableOscillator.h"
+
+namespace engine
+{
+
+/**
+ * @class engine::PolyBlepOscillator
+ * @brief An analytic saw and square oscillator, band-limited with polyBLEP
+ * 
+ * Same interface than engine::WavetableOscillator, but the waveforms are
+ * computed from the phase : a naive saw and square, which discontinuities
+ * are smoothed by a polynomial band-limited step. The aliasing is not as low
+ * as with the mipmapped wavetables, but nothing is read from memory, so this
+ * suits the builds without room for the tables.
+ * 
+ * The phase is accumulated first, the glide and the pitch noise being
+ * sequential. The waveforms are then computed without any branch from the
+ * phases of the block, which the compiler vectorises.
+ */
+class PolyBlepOscillator
+{
+public:
+    /**
+     * @param noiseStream The stream of the pitch noise, each oscillator of the
+     * engine should use its own
+     */
+    PolyBlepOscillator(Bindings bindings,
+            NoiseGenerator::StreamId noiseStream = NoiseGenerator::OSCILLATOR_1);
+
+//==============================================================================
+    /// juce::dsp::Oscillator like methods
+    void setFrequency(float newFreq, bool force=false) noexcept;
+    void prepare(float sampleRate, int blockSize) noexcept;
+    void reset() noexcept;
+
+    /**
+     * @brief Render gain * ((1 - ratio) * saw + ratio * square)
+     * 
+     * @param ratio      The crossfade ratio of each sample
+     * @param gain       The gain applied to the output
+     * @param output     The buffer to render into
+     * @param numSamples The number of samples to render
+     */
+    void processMorph(const float* ratio, float gain, float* output, int numSamples) noexcept;
+
+//==============================================================================
+    /**
+     * @brief Set the Glide time time, default to 0
+     * @note NOT thread-safe, should be called before each block
+     * 
+     * @param glideTime New glide time in seconds
+     */
+    void setGlide(float glideTime) noexcept;
+
+    /**
+     * @brief The polyBLEP residual of a step from -1 to 1 at the phase 0
+     * 
+     * @param phase      The phase, within [0; 1[
+     * @param phaseDelta The phase increment of one sample
+     */
+    static forcedinline float polyBlep(float phase, float phaseDelta) noexcept
+    {
+        // Within one sample after the step
+        auto after = phase / phaseDelta;
+        // Within one sample before the step
+        auto before = (phase - 1.f) / phaseDelta;
+
+        return phase < phaseDelta ? after + after - after * after - 1.f
+                : phase > 1.f - phaseDelta ? before * before + before + before + 1.f
+                : 0.f;
+    }
+
+private:
+//==============================================================================
+    NoiseGenerator                          m_noiseGenerator;
+    SmoothedFrequency                       m_frequency;
+    float                                   m_phase;
+    float                                   m_phaseDelta;
+    float                                   m_sampleRate;
+    float                                   m_glide;
+    juce::AudioBuffer<float>                m_noiseFactors;
+    // The phase and the phase increment of each sample of the block
+    juce::AudioBuffer<float>                m_phases;
+};
+
+} // namespace engine
@@ -0,0 +1,271 @@
+/*
+  ==============================================================================
+
+    UnisonStack.cpp
+    Created: 18 Oct 2026 4:27:13am
+    Author:  maxime
+
+  ==============================================================================
+*/
+
+#include "UnisonStack.h"
+
+#include "Engine/Oscillators/PolyBlepOscillator.h"
+
+namespace engine
+{
+
+// The first lane is the sub oscillator, the next ones the unison voices
+constexpr size_t SUB_LANE = 0;
+constexpr auto SUB_PITCH_RATIO = 0.5f;
+
+static_assert((WavetableBank::TABLE_SIZE & (WavetableBank::TABLE_SIZE - 1)) == 0,
+        "The table indexes are wrapped with a mask");
+
+UnisonStack::UnisonStack(Bindings bindings, bool analytic)
+    : m_noiseGenerator(bindings.r_noiseGenerator.fork(NoiseGenerator::UNISON_STACK)),
+      m_frequency(440.0f),
+      m_phaseDelta(0.0f),
+      m_sampleRate(0.0f),
+      m_glide(0.0f),
+      m_noiseFactors(),
+      m_analytic(analytic),
+      m_numVoices(1),
+      m_numLanes(1),
+      m_detune(0.0f),
+      m_subLevel(0.0f),
+      m_voiceGain(1.0f),
+      m_mainPitchRatio(1.0f),
+      m_active(false),
+      m_phases(),
+      m_pitchRatios(),
+      m_gains(),
+      m_samples(),
+      m_levels()
+{
+    m_pitchRatios.fill(1.0f);
+    m_pitchRatios[SUB_LANE] = SUB_PITCH_RATIO;
+    m_gains.fill(0.0f);
+    m_levels.fill(0);
+}
+
+void UnisonStack::setFrequency(float newFreq, bool force) noexcept
+{
+    if (force || m_glide == 0.0)
+    {
+        m_frequency.setCurrentAndTargetValue(newFreq);
+
+        if (m_sampleRate > 0)
+        {
+            m_phaseDelta = m_frequency.getCurrentValue() / m_sampleRate;
+        }
+        return;
+    }
+
+    m_frequency.setTargetValue(newFreq);
+}
+
+void UnisonStack::prepare(float sampleRate, int blockSize) noexcept
+{
+    m_sampleRate = sampleRate;
+    m_phaseDelta = m_frequency.getCurrentValue() / m_sampleRate;
+    m_frequency.reset(m_sampleRate, m_glide);
+    m_noiseFactors.setSize(1, blockSize);
+
+    // The sub starts with the main oscillator, the unison voices are spread
+    // so they do not start in phase
+    for (auto lane = 0; lane < NUM_LANES; ++lane)
+    {
+        m_phases[size_t(lane)] = float(lane) / float(NUM_LANES);
+    }
+    m_phases[SUB_LANE] = 0.0f;
+}
+
+void UnisonStack::reset() noexcept
+{
+    m_sampleRate = 0.0;
+}
+
+void UnisonStack::setVoices(int numVoices, float detune, float subLevel) noexcept
+{
+    numVoices = juce::jlimit(1, MAX_UNISON_VOICES, numVoices);
+
+    if (numVoices == m_numVoices && detune == m_detune && subLevel == m_subLevel)
+    {
+        return;
+    }
+
+    m_numVoices = numVoices;
+    m_numLanes = numVoices;
+    m_detune = detune;
+    m_subLevel = subLevel;
+    m_voiceGain = 1.0f / std::sqrt(float(numVoices));
+    m_active = numVoices > 1 || subLevel > 0.0f;
+
+    m_gains[SUB_LANE] = subLevel;
+
+    // The voices are evenly spaced from -detune to +detune, the main one takes
+    // the middle slot, just above the note with an even number of voices
+    auto centsPerVoice = numVoices > 1 ? 2.0f * detune / float(numVoices - 1) : 0.0f;
+    auto getPitchRatio = [=](int voice) {
+        return std::exp2((float(voice) - 0.5f * float(numVoices - 1)) * centsPerVoice / 1200.0f);
+    };
+    auto mainVoice = numVoices / 2;
+    m_mainPitchRatio = getPitchRatio(mainVoice);
+
+    for (auto lane = 1; lane < NUM_LANES; ++lane)
+    {
+        if (lane >= m_numLanes)
+        {
+            m_pitchRatios[size_t(lane)] = 1.0f;
+            m_gains[size_t(lane)] = 0.0f;
+            continue;
+        }
+
+        // The lanes take the other slots, skipping the main one
+        auto voice = lane - 1 < mainVoice ? lane - 1 : lane;
+        m_pitchRatios[size_t(lane)] = getPitchRatio(voice);
+        m_gains[size_t(lane)] = m_voiceGain;
+    }
+}
+
+void UnisonStack::process(const WavetableBank& bank, const float* position, float gain,
+        float* output, int numSamples) noexcept
+{
+    jassert(numSamples <= m_noiseFactors.getNumSamples());
+
+    if (! m_active)
+    {
+        return;
+    }
+
+    // The pitch noise of the whole block is drawn at once, for all the lanes
+    auto* noise = m_noiseFactors.getWritePointer(0);
+    m_noiseGenerator.fillNoiseFactors(noise, numSamples);
+
+    if (! m_analytic)
+    {
+        updateMipmapLevels(bank);
+    }
+
+    for (auto i = 0; i < numSamples; ++i)
+    {
+        if (m_frequency.isSmoothing())
+        {
+            m_phaseDelta = m_frequency.getNextValue() / m_sampleRate;
+        }
+
+        auto phaseDelta = m_phaseDelta * noise[i];
+        auto sample = m_analytic ? renderAnalytic(position[i], phaseDelta)
+                : renderTables(bank, position[i]);
+
+        advancePhases(phaseDelta);
+        output[i] += gain * sample;
+    }
+}
+
+void UnisonStack::setGlide(float glideTime) noexcept
+{
+    jassert(glideTime >= 0.0);
+
+    if (glideTime == m_glide)
+    {
+        return;
+    }
+
+    m_glide = glideTime;
+
+    if (!(m_sampleRate > 0))
+    {
+        // If the samplerate is not set, no need to update the smoothedFreq
+        return;
+    }
+
+    if (glideTime > 0.)
+    {
+        m_frequency.update(m_sampleRate, glideTime);
+    }
+    else if (glideTime == 0.)
+    {
+        m_frequency.skipRamp();
+    }
+}
+
+//==============================================================================
+forcedinline void UnisonStack::advancePhases(float phaseDelta) noexcept
+{
+    // Every lane at once, without any branch
+    for (auto lane = 0; lane < NUM_LANES; ++lane)
+    {
+        auto phase = m_phases[size_t(lane)] + phaseDelta * m_pitchRatios[size_t(lane)];
+        m_phases[size_t(lane)] = phase >= 1.0f ? phase - 1.0f : phase;
+    }
+}
+
+void UnisonStack::updateMipmapLevels(const WavetableBank& bank) noexcept
+{
+    auto lastLevel = bank.getNumLevels() - 1;
+    auto tableDelta = m_phaseDelta * float(WavetableBank::TABLE_SIZE);
+
+    // Unlike the main oscillator, the levels are not crossfaded : each lane
+    // reads the level alias free at its pitch, once per block
+    for (auto lane = 0; lane < m_numLanes; ++lane)
+    {
+        auto laneDelta = juce::jmax(tableDelta * m_pitchRatios[size_t(lane)], 1.0f);
+        m_levels[size_t(lane)] = juce::jlimit(0, lastLevel, int(std::ceil(std::log2(laneDelta))));
+    }
+}
+
+float UnisonStack::renderTables(const WavetableBank& bank, float position) noexcept
+{
+    constexpr auto indexMask = unsigned(WavetableBank::TABLE_SIZE - 1);
+    auto morph = bank.getMorph(position);
+    auto sum = 0.0f;
+
+    // The table reads are gathers, they stay scalar and skip the unused lanes
+    for (auto lane = 0; lane < m_numLanes; ++lane)
+    {
+        auto index = m_phases[size_t(lane)] * float(WavetableBank::TABLE_SIZE);
+        auto idx0 = unsigned(index) & indexMask;
+        auto idx1 = (idx0 + 1) & indexMask;
+        auto frac = index - float(idx0);
+
+        auto* frameA = bank.getLevel(morph.m_lowerFrame, m_levels[size_t(lane)]);
+        auto* frameB = bank.getLevel(morph.m_upperFrame, m_levels[size_t(lane)]);
+        auto sampleA = frameA[idx0] + frac * (frameA[idx1] - frameA[idx0]);
+        auto sampleB = frameB[idx0] + frac * (frameB[idx1] - frameB[idx0]);
+
+        sum += m_gains[size_t(lane)] * (sampleA + morph.m_frac * (sampleB - sampleA));
+    }
+
+    return sum;
+}
+
+float UnisonStack::renderAnalytic(float ratio, float phaseDelta) noexcept
+{
+    // The waveforms only depend on the phases, this loop is vectorised
+    for (auto lane = 0; lane < NUM_LANES; ++lane)
+    {
+        auto phase = m_phases[size_t(lane)];
+        auto laneDelta = phaseDelta * m_pitchRatios[size_t(lane)];
+        auto halfPhase = phase < 0.5f ? phase + 0.5f : phase - 0.5f;
+
+        auto saw = 2.f * phase - 1.f - PolyBlepOscillator::polyBlep(phase, laneDelta);
+        auto square = (phase < 0.5f ? 1.f : -1.f)
+                + PolyBlepOscillator::polyBlep(phase, laneDelta)
+                - PolyBlepOscillator::polyBlep(halfPhase, laneDelta);
+
+        m_samples[size_t(lane)] = m_gains[size_t(lane)] * (saw + ratio * (square - saw));
+    }
+
+    auto sum = 0.0f;
+
+    for (auto& sample : m_samples)
+    {
+        sum += sample;
+    }
+
+    return sum;
+}
+
+} // namespace engine
@@ -0,0 +1,153 @@
+/*
+  ==============================================================================
+
+    UnisonStack.h
+    Created: 18 Oct 2026 4:27:13am
+    Author:  maxime
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+
+#include <JuceHeader.h>
+
+#include "Engine/Binding.h"
+#include "Engine/Oscillators/WavetableOscillator.h"
+
+namespace engine
+{
+
+/**
+ * @class engine::UnisonStack
+ * @brief The detuned unison voices and the sub oscillator of the
+ * engine::DualOscillator
+ *
+ * The stack adds to the output of the main oscillator up to MAX_UNISON_VOICES - 1
+ * voices spread around its pitch, and a sub oscillator one octave down. Each
+ * of them is a lane of the stack : the phases are stored side by side and
+ * advanced together by a single loop over the lanes, which the compiler
+ * vectorises. The unused lanes have a gain of 0, only the table reads, which
+ * are gathers, stop at the last used lane.
+ *
+ * The voices are spread evenly between -detune and +detune cents around the
+ * note. With an even number of voices none of them is on the note, the main
+ * oscillator must then be detuned by getMainPitchRatio().
+ *
+ * The lanes read the frames of the engine::WavetableBank, each one from the
+ * mipmap level matching its own pitch, or compute a polyBLEP saw and square
+ * like engine::PolyBlepOscillator.
+ */
+class UnisonStack
+{
+public:
+    /**
+     * @brief The voices of the unison, the main oscillator included
+     */
+    static constexpr int MAX_UNISON_VOICES = 8;
+    /**
+     * @brief The sub oscillator and the unison voices but the main one
+     */
+    static constexpr int NUM_LANES = MAX_UNISON_VOICES;
+
+    /**
+     * @param analytic Compute the waveforms instead of reading the wavetables
+     */
+    UnisonStack(Bindings bindings, bool analytic = false);
+
+//==============================================================================
+    /// juce::dsp::Oscillator like methods
+    void setFrequency(float newFreq, bool force=false) noexcept;
+    void prepare(float sampleRate, int blockSize) noexcept;
+    void reset() noexcept;
+
+    /**
+     * @brief Set the voices of the stack, should be called before each block
+     *
+     * @param numVoices The number of unison voices, the main oscillator included
+     * @param detune    The pitch of the outermost voices, in cents
+     * @param subLevel  The gain of the sub oscillator, relative to a voice
+     */
+    void setVoices(int numVoices, float detune, float subLevel) noexcept;
+
+    /**
+     * @brief The gain to apply to each voice of the unison, the main
+     * oscillator included, to keep the loudness of a single voice
+     */
+    float getVoiceGain() const noexcept { return m_voiceGain; }
+
+    /**
+     * @brief The pitch ratio of the main oscillator within the spread, 1 with
+     * an odd number of voices
+     */
+    float getMainPitchRatio() const noexcept { return m_mainPitchRatio; }
+
+    /**
+     * @brief false when the stack has nothing to render
+     */
+    bool isActive() const noexcept { return m_active; }
+
+    /**
+     * @brief Add the voices of the stack to the output
+     *
+     * @param bank       The frames to morph between
+     * @param position   The morph position of each sample, within [0; 1]
+     * @param gain       The gain applied to the voices
+     * @param output     The buffer to add into
+     * @param numSamples The number of samples to render
+     */
+    void process(const WavetableBank& bank, const float* position, float gain,
+            float* output, int numSamples) noexcept;
+
+//==============================================================================
+    /**
+     * @brief Set the Glide time time, default to 0
+     * @note NOT thread-safe, should be called before each block
+     *
+     * @param glideTime New glide time in seconds
+     */
+    void setGlide(float glideTime) noexcept;
+
+private:
+    using Lanes = std::array<float, NUM_LANES>;
+
+    /**
+     * @brief Advance the phase of every lane by one sample
+     */
+    forcedinline void advancePhases(float phaseDelta) noexcept;
+    /**
+     * @brief Select the mipmap level read by each lane
+     */
+    void updateMipmapLevels(const WavetableBank& bank) noexcept;
+    float renderTables(const WavetableBank& bank, float position) noexcept;
+    float renderAnalytic(float ratio, float phaseDelta) noexcept;
+
+//==============================================================================
+    NoiseGenerator                          m_noiseGenerator;
+    SmoothedFrequency                       m_frequency;
+    float                                   m_phaseDelta;
+    float                                   m_sampleRate;
+    float                                   m_glide;
+    juce::AudioBuffer<float>                m_noiseFactors;
+    bool                                    m_analytic;
+
+    int                                     m_numVoices;
+    // The sub and the unison voices but the main one
+    int                                     m_numLanes;
+    float                                   m_detune;
+    float                                   m_subLevel;
+    float                                   m_voiceGain;
+    float                                   m_mainPitchRatio;
+    bool                                    m_active;
+
+    // The state of the lanes, stored side by side to be vectorised
+    alignas(32) Lanes                       m_phases;
+    alignas(32) Lanes                       m_pitchRatios;
+    alignas(32) Lanes                       m_gains;
+    alignas(32) Lanes                       m_samples;
+    std::array<int, NUM_LANES>              m_levels;
+};
+
+} // namespace engine
@@ -0,0 +1,149 @@
+/*
+  ==============================================================================
+
+    WavetableBank.cpp
+    Created: 18 Oct 2026 2:17:35am
+    Author:  maxime
+
+  ==============================================================================
+*/
+
+#include "WavetableBank.h"
+
+#include "Utils/Utils.h"
+
+namespace engine
+{
+
+// A longer file is not a single cycle
+constexpr juce::int64 MAX_FRAME_LENGTH = 65536;
+
+static_assert((WavetableBank::TABLE_SIZE * sizeof(float)) % WavetableBank::ALIGNMENT_BYTES == 0,
+        "The levels would not all be aligned");
+
+WavetableBank::WavetableBank(bool withDefaultFrames)
+    : m_storage(),
+      m_levels(),
+      m_frames(),
+      m_numFrames(0),
+      m_numLevels(0)
+{
+    if (! withDefaultFrames)
+    {
+        return;
+    }
+
+    auto frames = std::vector<juce::AudioSampleBuffer>(2);
+    utils::waveform::loadWavetableFromBinaryWaveFile(frames[0],
+            BinaryData::waveform_saw_wav, BinaryData::waveform_saw_wavSize);
+    utils::waveform::loadWavetableFromBinaryWaveFile(frames[1],
+            BinaryData::waveform_square_wav, BinaryData::waveform_square_wavSize);
+
+    setFrames(frames);
+}
+
+//==============================================================================
+bool WavetableBank::loadFromDirectory(const juce::File& directory)
+{
+    auto files = directory.findChildFiles(juce::File::findFiles, false, "*.wav");
+    files.sort();
+
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+    auto frames = std::vector<juce::AudioSampleBuffer>();
+
+    for (auto& file : files)
+    {
+        if (frames.size() == size_t(MAX_FRAMES))
+        {
+            DBG("Too many wavetables, only the first " + juce::String(MAX_FRAMES) + " are used");
+            break;
+        }
+
+        auto reader = std::unique_ptr<juce::AudioFormatReader>(
+                formatManager.createReaderFor(file));
+
+        if (reader == nullptr || reader->lengthInSamples < 2
+                || reader->lengthInSamples > MAX_FRAME_LENGTH)
+        {
+            DBG("Skipping the wavetable " + file.getFileName());
+            continue;
+        }
+
+        auto numSamples = int(reader->lengthInSamples);
+        auto frame = juce::AudioSampleBuffer(1, numSamples);
+        reader->read(&frame, 0, numSamples, 0, true, false);
+        frames.push_back(std::move(frame));
+    }
+
+    if (frames.empty())
+    {
+        return false;
+    }
+
+    setFrames(frames);
+    return true;
+}
+
+void WavetableBank::setFrames(const std::vector<juce::AudioSampleBuffer>& frames)
+{
+    jassert(! frames.empty());
+
+    m_numFrames = juce::jmin(int(frames.size()), MAX_FRAMES);
+    m_numLevels = utils::waveform::getNumMipmapLevels(TABLE_SIZE);
+
+    // A single allocation for all the levels, aligned on its first one
+    auto numTables = size_t(m_numFrames * m_numLevels);
+    m_storage.allocate(numTables * TABLE_SIZE + ALIGNMENT_BYTES / sizeof(float), false);
+    auto* firstLevel = juce::snapPointerToAlignment(m_storage.get(), ALIGNMENT_BYTES);
+
+    m_levels.resize(numTables);
+
+    for (auto table = size_t(0); table < numTables; ++table)
+    {
+        m_levels[table] = firstLevel + table * TABLE_SIZE;
+    }
+
+    auto mipmap = juce::AudioSampleBuffer();
+
+    for (auto frame = 0; frame < m_numFrames; ++frame)
+    {
+        // Resample the cycle to the table size
+        auto& source = frames[size_t(frame)];
+        auto sourceSize = source.getNumSamples();
+        auto* sourceData = source.getReadPointer(0);
+        jassert(sourceSize > 0);
+
+        mipmap.setSize(1, TABLE_SIZE);
+        auto* data = mipmap.getWritePointer(0);
+
+        for (auto i = 0; i < TABLE_SIZE; ++i)
+        {
+            auto position = double(i) * sourceSize / TABLE_SIZE;
+            auto idx0 = int(position);
+            auto idx1 = (idx0 + 1) % sourceSize;
+            auto frac = float(position - idx0);
+
+            data[i] = sourceData[idx0] + frac * (sourceData[idx1] - sourceData[idx0]);
+        }
+
+        utils::waveform::buildMipmaps(mipmap);
+        jassert(mipmap.getNumChannels() == m_numLevels);
+
+        for (auto level = 0; level < m_numLevels; ++level)
+        {
+            std::copy_n(mipmap.getReadPointer(level), TABLE_SIZE,
+                    m_levels[size_t(frame * m_numLevels + level)]);
+        }
+    }
+
+    // The oscillators read the frames through regular buffers
+    m_frames.clear();
+
+    for (auto frame = 0; frame < m_numFrames; ++frame)
+    {
+        m_frames.emplace_back(m_levels.data() + frame * m_numLevels, m_numLevels, TABLE_SIZE);
+    }
+}
+
+} // namespace engine
@@ -0,0 +1,130 @@
+/*
+  ==============================================================================
+
+    WavetableBank.h
+    Created: 18 Oct 2026 2:17:35am
+    Author:  maxime
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace engine
+{
+
+/**
+ * @class engine::WavetableBank
+ * @brief A bank of single cycle frames, the oscillators morph between two
+ * adjacent frames with the waveform ratio
+ *
+ * Every frame is resampled to TABLE_SIZE and band-limited into the mipmap
+ * levels of utils::waveform::buildMipmaps. All the levels of all the frames
+ * are stored contiguously in a single buffer, each of them aligned for SIMD
+ * reads. Morphing always reads two frames, so the cost per sample does not
+ * depend on the number of frames.
+ *
+ * The default bank holds the saw and the square of the resources, a user
+ * directory of wav files can replace them at startup. An empty bank holds no
+ * frame at all, it must not be read.
+ *
+ * @note The bank is shared by all the oscillators, it must be loaded before
+ * they are prepared and never changed afterward
+ */
+class WavetableBank
+{
+public:
+    static constexpr int TABLE_SIZE = 2048;
+    static constexpr int MAX_FRAMES = 64;
+    // Every level starts on a cache line
+    static constexpr size_t ALIGNMENT_BYTES = 64;
+
+    /**
+     * @brief The two frames to read for a morph position, and the crossfade
+     * amount between them
+     */
+    struct Morph
+    {
+        int     m_lowerFrame;
+        int     m_upperFrame;
+        float   m_frac;
+    };
+
+    /**
+     * @brief Build the default bank, the saw then the square
+     *
+     * @param withDefaultFrames false to build an empty bank, which allocates
+     * nothing, for the engines that never read the tables
+     */
+    explicit WavetableBank(bool withDefaultFrames = true);
+
+//==============================================================================
+    /**
+     * @brief Load every wav file of the directory as a frame, sorted by name
+     *
+     * Only the first channel of each file is read, as a single cycle.
+     *
+     * @return false if the directory holds no valid frame, the bank is then
+     * left unchanged
+     */
+    bool loadFromDirectory(const juce::File& directory);
+    /**
+     * @brief Replace the frames of the bank
+     *
+     * @param frames Single cycle frames, in the first channel of each buffer,
+     * of any size. At most MAX_FRAMES are kept
+     */
+    void setFrames(const std::vector<juce::AudioSampleBuffer>& frames);
+
+//==============================================================================
+    int getNumFrames() const noexcept { return m_numFrames; }
+    int getNumLevels() const noexcept { return m_numLevels; }
+
+    /**
+     * @brief Get one frame, its mipmap levels being its channels
+     */
+    const juce::AudioSampleBuffer& getFrame(int frame) const noexcept
+    {
+        jassert(frame >= 0 && frame < m_numFrames);
+        return m_frames[size_t(frame)];
+    }
+
+    /**
+     * @brief Get one mipmap level of a frame
+     */
+    forcedinline const float* getLevel(int frame, int level) const noexcept
+    {
+        jassert(frame >= 0 && frame < m_numFrames);
+        jassert(level >= 0 && level < m_numLevels);
+        return m_levels[size_t(frame * m_numLevels + level)];
+    }
+
+    /**
+     * @brief Map a morph position within [0; 1] onto the frames, 0 being the
+     * first frame and 1 the last one
+     */
+    forcedinline Morph getMorph(float position) const noexcept
+    {
+        auto framePosition = juce::jlimit(0.f, 1.f, position) * float(m_numFrames - 1);
+        auto lowerFrame = juce::jmin(int(framePosition), juce::jmax(m_numFrames - 2, 0));
+
+        return {lowerFrame, juce::jmin(lowerFrame + 1, m_numFrames - 1),
+                framePosition - float(lowerFrame)};
+    }
+
+private:
+//==============================================================================
+    // The levels of all the frames, frame after frame
+    juce::HeapBlock<float>                  m_storage;
+    std::vector<float*>                     m_levels;
+    // Views on the levels of each frame
+    std::vector<juce::AudioSampleBuffer>    m_frames;
+    int                                     m_numFrames;
+    int                                     m_numLevels;
+
+    JUCE_DECLARE_NON_COPYABLE(WavetableBank)
+};
+
+} // namespace engine
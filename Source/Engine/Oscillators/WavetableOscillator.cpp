@@ -15,15 +15,22 @@ namespace engine
 
 WavetableOscillator::WavetableOscillator(
     const juce::AudioSampleBuffer& wavetable,
-    Bindings bindings)
+    Bindings bindings,
+    NoiseGenerator::StreamId noiseStream)
     : m_wavetable(wavetable),
-      r_noiseGenerator(bindings.r_noiseGenerator),
+      m_noiseGenerator(bindings.r_noiseGenerator.fork(noiseStream)),
       m_frequency(440.0f),
       m_currentIndex(0.0f),
       m_tableDelta(0.0f),
+      m_lowerLevel(nullptr),
+      m_upperLevel(nullptr),
+      m_lowerLevelIndex(0),
+      m_upperLevelIndex(0),
+      m_levelFrac(0.0f),
       m_tableSizeOverSampleRate(0.0f),
       m_sampleRate(0.0),
-      m_glide(0.0)
+      m_glide(0.0),
+      m_noiseFactors()
 {
     // Nothing to do here
 }
@@ -34,6 +41,12 @@ void WavetableOscillator::setFrequency(float newFreq, bool force) noexcept
     {
         m_frequency.setCurrentAndTargetValue(newFreq);
         m_tableDelta = m_frequency.getCurrentValue() * m_tableSizeOverSampleRate;
+
+        // The wavetable might not be filled before prepare() is called
+        if (m_sampleRate > 0)
+        {
+            updateMipmapLevel();
+        }
         return;
     }
 
@@ -42,7 +55,7 @@ void WavetableOscillator::setFrequency(float newFreq, bool force) noexcept
 
 void WavetableOscillator::prepare(float sampleRate, int blockSize) noexcept
 {
-    jassert(m_wavetable.getNumChannels() == 1);
+    jassert(m_wavetable.getNumChannels() >= 1);
     jassert(m_wavetable.getNumSamples() > 0);
 
     m_tableSizeOverSampleRate = float(m_wavetable.getNumSamples()) / sampleRate;
@@ -50,6 +63,8 @@ void WavetableOscillator::prepare(float sampleRate, int blockSize) noexcept
     m_tableDelta = 0.0f;
     m_sampleRate = sampleRate;
     m_frequency.reset(m_sampleRate, m_glide);
+    m_noiseFactors.setSize(1, blockSize);
+    updateMipmapLevel();
 }
 
 void WavetableOscillator::reset() noexcept
@@ -63,23 +78,129 @@ void WavetableOscillator::process(const juce::dsp::ProcessContextReplacing<float
     jassert(outblock.getNumChannels() == 1);
     auto numSamples = int(outblock.getNumSamples());
     auto* data = outblock.getChannelPointer(0);
+    jassert(numSamples <= m_noiseFactors.getNumSamples());
+
+    // The pitch noise of the whole block is drawn at once
+    auto* noise = m_noiseFactors.getWritePointer(0);
+    m_noiseGenerator.fillNoiseFactors(noise, numSamples);
 
     // Processing with freq smoothing, should not happens to often
     while (m_frequency.isSmoothing() && numSamples-- > 0)
     {
         m_tableDelta = m_frequency.getNextValue() * m_tableSizeOverSampleRate;
-        *data = getNextSample();
+        updateMipmapLevel();
+        *data = getNextSample(*noise++);
         ++data;
     }
 
     // Processing without freq smoothing
     while (numSamples-- > 0)
     {
-        *data = getNextSample();
+        *data = getNextSample(*noise++);
         ++data;
     }
 }
 
+void WavetableOscillator::processMorph(const WavetableBank& bank, const float* position,
+        float gain, float* output, int numSamples, bool useSIMD) noexcept
+{
+    jassert(bank.getFrame(0).getNumSamples() == m_wavetable.getNumSamples());
+    jassert(bank.getNumLevels() == m_wavetable.getNumChannels());
+    jassert(numSamples <= m_noiseFactors.getNumSamples());
+
+    // The pitch noise of the whole block is drawn at once, for all the frames
+    auto* noise = m_noiseFactors.getWritePointer(0);
+    m_noiseGenerator.fillNoiseFactors(noise, numSamples);
+    auto i = 0;
+
+    // Processing with freq smoothing, should not happens to often
+    for (; m_frequency.isSmoothing() && i < numSamples; ++i)
+    {
+        m_tableDelta = m_frequency.getNextValue() * m_tableSizeOverSampleRate;
+        updateMipmapLevel();
+        output[i] = gain * getNextMorphedSample(bank, position[i], noise[i]);
+    }
+
+    // Processing without freq smoothing
+    if (useSIMD)
+    {
+        i += processMorphSIMD(bank, position + i, gain, output + i, noise + i, numSamples - i);
+    }
+
+    for (; i < numSamples; ++i)
+    {
+        output[i] = gain * getNextMorphedSample(bank, position[i], noise[i]);
+    }
+}
+
+int WavetableOscillator::processMorphSIMD(const WavetableBank& bank, const float* position,
+        float gain, float* output, const float* noise, int numSamples) noexcept
+{
+#if JUCE_USE_SIMD
+    using Vector = juce::dsp::SIMDRegister<float>;
+    constexpr auto numElements = int(Vector::SIMDNumElements);
+
+    // The points read in the two frames for each sample of a register
+    enum Point
+    {
+        A_LOWER_0, A_UPPER_0, A_LOWER_1, A_UPPER_1,
+        B_LOWER_0, B_UPPER_0, B_LOWER_1, B_UPPER_1,
+        FRAC, MORPH, OUTPUT, NUM_POINTS
+    };
+    alignas(Vector::SIMDRegisterSize) float points[NUM_POINTS][numElements];
+
+    auto tableSize = unsigned(m_wavetable.getNumSamples());
+    auto levelFrac = Vector::expand(m_levelFrac);
+    auto numRendered = numSamples - numSamples % numElements;
+
+    auto load = [&points](Point point) { return Vector::fromRawArray(points[point]); };
+    auto lerp = [](Vector a, Vector b, Vector amount) { return a + amount * (b - a); };
+
+    for (auto start = 0; start < numRendered; start += numElements)
+    {
+        // The phase and the table reads stay scalar
+        for (auto k = 0; k < numElements; ++k)
+        {
+            auto idx0 = (unsigned int) m_currentIndex;
+            auto idx1 = idx0 == (tableSize - 1) ? (unsigned int) 0 : idx0 + 1;
+            auto morph = bank.getMorph(position[start + k]);
+            auto* lowerA = bank.getLevel(morph.m_lowerFrame, m_lowerLevelIndex);
+            auto* upperA = bank.getLevel(morph.m_lowerFrame, m_upperLevelIndex);
+            auto* lowerB = bank.getLevel(morph.m_upperFrame, m_lowerLevelIndex);
+            auto* upperB = bank.getLevel(morph.m_upperFrame, m_upperLevelIndex);
+
+            points[A_LOWER_0][k] = lowerA[idx0];
+            points[A_UPPER_0][k] = upperA[idx0];
+            points[A_LOWER_1][k] = lowerA[idx1];
+            points[A_UPPER_1][k] = upperA[idx1];
+            points[B_LOWER_0][k] = lowerB[idx0];
+            points[B_UPPER_0][k] = upperB[idx0];
+            points[B_LOWER_1][k] = lowerB[idx1];
+            points[B_UPPER_1][k] = upperB[idx1];
+            points[FRAC][k] = m_currentIndex - idx0;
+            points[MORPH][k] = morph.m_frac;
+
+            advancePhase(noise[start + k]);
+        }
+
+        // The interpolations and the morph are computed on whole registers
+        auto frac = load(FRAC);
+        auto a = lerp(lerp(load(A_LOWER_0), load(A_UPPER_0), levelFrac),
+                lerp(load(A_LOWER_1), load(A_UPPER_1), levelFrac), frac);
+        auto b = lerp(lerp(load(B_LOWER_0), load(B_UPPER_0), levelFrac),
+                lerp(load(B_LOWER_1), load(B_UPPER_1), levelFrac), frac);
+
+        (lerp(a, b, load(MORPH)) * gain).copyToRawArray(points[OUTPUT]);
+        std::copy_n(points[OUTPUT], numElements, output + start);
+    }
+
+    return numRendered;
+#else
+    juce::ignoreUnused(bank, position, gain, output, noise, numSamples);
+    return 0;
+#endif
+}
+
 void WavetableOscillator::setGlide(float glideTime) noexcept
 {
     jassert(glideTime >= 0.0);
@@ -107,29 +228,84 @@ void WavetableOscillator::setGlide(float glideTime) noexcept
     }
 }
 
-forcedinline float WavetableOscillator::getNextSample() noexcept
+void WavetableOscillator::updateMipmapLevel() noexcept
+{
+    auto lastLevel = m_wavetable.getNumChannels() - 1;
+
+    // Level L is alias free up to a table delta of 2^(L+1)
+    auto position = juce::jlimit(0.0f, float(lastLevel),
+            std::log2(juce::jmax(m_tableDelta, 1.0f)));
+    auto lowerLevel = int(position);
+    auto upperLevel = juce::jmin(lowerLevel + 1, lastLevel);
+
+    m_lowerLevelIndex = lowerLevel;
+    m_upperLevelIndex = upperLevel;
+    m_lowerLevel = m_wavetable.getReadPointer(lowerLevel);
+    m_upperLevel = m_wavetable.getReadPointer(upperLevel);
+    m_levelFrac = position - float(lowerLevel);
+}
+
+forcedinline float WavetableOscillator::getNextSample(float noiseFactor) noexcept
+{
+    auto tableSize = m_wavetable.getNumSamples();
+
+    auto idx0 = (unsigned int) m_currentIndex;
+    auto idx1 = idx0 == (tableSize - 1) ? (unsigned int) 0 : idx0 + 1;
+
+    auto frac = m_currentIndex - idx0;
+
+    auto interpolatedSample = readLevels(m_lowerLevel, m_upperLevel, idx0, idx1, frac);
+
+    advancePhase(noiseFactor);
+
+    return interpolatedSample;
+}
+
+forcedinline float WavetableOscillator::getNextMorphedSample(const WavetableBank& bank,
+        float position, float noiseFactor) noexcept
 {
     auto tableSize = m_wavetable.getNumSamples();
-    auto* table = m_wavetable.getReadPointer(0);
 
     auto idx0 = (unsigned int) m_currentIndex;
     auto idx1 = idx0 == (tableSize - 1) ? (unsigned int) 0 : idx0 + 1;
 
     auto frac = m_currentIndex - idx0;
 
-    auto value0 = table[idx0];
-    auto value1 = table[idx1];
+    // Both frames are read at the same points
+    auto morph = bank.getMorph(position);
+    auto sampleA = readLevels(bank.getLevel(morph.m_lowerFrame, m_lowerLevelIndex),
+            bank.getLevel(morph.m_lowerFrame, m_upperLevelIndex), idx0, idx1, frac);
+    auto sampleB = readLevels(bank.getLevel(morph.m_upperFrame, m_lowerLevelIndex),
+            bank.getLevel(morph.m_upperFrame, m_upperLevelIndex), idx0, idx1, frac);
+
+    advancePhase(noiseFactor);
 
-    auto interpolatedSample = value0 + frac * (value1 - value0);
+    return sampleA + morph.m_frac * (sampleB - sampleA);
+}
 
-    m_currentIndex += m_tableDelta * r_noiseGenerator.getNoiseFactor();
+forcedinline float WavetableOscillator::readLevels(const float* lowerLevel,
+        const float* upperLevel, unsigned int idx0, unsigned int idx1, float frac) const noexcept
+{
+    // Both levels are crossfaded before the interpolation, the crossfade
+    // amount being the same for the two points
+    auto value0 = lowerLevel[idx0] + m_levelFrac * (upperLevel[idx0] - lowerLevel[idx0]);
+    auto value1 = lowerLevel[idx1] + m_levelFrac * (upperLevel[idx1] - lowerLevel[idx1]);
 
-    if (m_currentIndex > (float) tableSize)
+    return value0 + frac * (value1 - value0);
+}
+
+forcedinline void WavetableOscillator::advancePhase(float noiseFactor) noexcept
+{
+    auto tableSize = (float) m_wavetable.getNumSamples();
+
+    m_currentIndex += m_tableDelta * noiseFactor;
+
+    // The index must stay below the size : the levels of the bank are stored
+    // one after another, a read past the end would hit the next one
+    if (m_currentIndex >= tableSize)
     {
-        m_currentIndex -= (float) tableSize;
+        m_currentIndex -= tableSize;
     }
-
-    return interpolatedSample;
 }
 
 } // namespace engine
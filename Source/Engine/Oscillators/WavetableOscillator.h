@@ -13,6 +13,7 @@
 #include <JuceHeader.h>
 
 #include "Engine/Binding.h"
+#include "Engine/Oscillators/WavetableBank.h"
 
 #include "Utils/CustomSmoothValue.h"
 
@@ -30,6 +31,15 @@ using SmoothedFrequency = utils::CustomSmoothedValue<float, juce::ValueSmoothing
  * The oscillator will use the entire AudioSampleBuffer provided as the waveform
  * The more higher the samplerate, the more points the wavetable should contains
  * in order to avoid interpolation artifacts
+ *
+ * If the buffer holds several channels, they are read as the band-limited
+ * mipmap levels built by utils::waveform::buildMipmaps. The oscillator then
+ * crossfades the two levels matching its table delta, so high notes do not
+ * alias. A mono buffer is read as is.
+ *
+ * processMorph() reads the frames of an engine::WavetableBank instead, with
+ * the same phase and mipmap levels, so the frames are morphed in a single
+ * pass. The wavetable must then be one of the frames of the bank.
  */
 class WavetableOscillator
 {
@@ -40,9 +50,12 @@ public:
      * @param wavetable A reference to the sample buffer to use as a waveform. 
      * The buffer does not need to be filled at build time, but should be 
      * initialised before calling WavetableOscillator::prepare method.
+     * @param noiseStream The stream of the pitch noise, each oscillator of the
+     * engine should use its own
      */
     WavetableOscillator(const juce::AudioSampleBuffer& wavetable, 
-            Bindings bindings);
+            Bindings bindings,
+            NoiseGenerator::StreamId noiseStream = NoiseGenerator::OSCILLATOR_1);
 
 //==============================================================================
     /// juce::dsp::Oscillator like methods
@@ -51,6 +64,21 @@ public:
     void reset() noexcept;
     void process(const juce::dsp::ProcessContextReplacing<float>& context) noexcept;
 
+    /**
+     * @brief Render the morph between the two frames of the bank matching the
+     * position of each sample, see WavetableBank::getMorph()
+     * 
+     * @param bank       The frames to morph between
+     * @param position   The morph position of each sample, within [0; 1]
+     * @param gain       The gain applied to the output
+     * @param output     The buffer to render into
+     * @param numSamples The number of samples to render
+     * @param useSIMD    Compute several samples per iteration when the
+     * platform supports it
+     */
+    void processMorph(const WavetableBank& bank, const float* position, float gain,
+            float* output, int numSamples, bool useSIMD = true) noexcept;
+
 //==============================================================================
     /**
      * @brief Set the Glide time time, default to 0
@@ -61,17 +89,42 @@ public:
     void setGlide(float glideTime) noexcept;
 
 private:
-    forcedinline float getNextSample() noexcept;
+    forcedinline float getNextSample(float noiseFactor) noexcept;
+    forcedinline float getNextMorphedSample(const WavetableBank& bank, float position,
+            float noiseFactor) noexcept;
+    /**
+     * @brief Read the current mipmap levels of a wavetable at the given points
+     */
+    forcedinline float readLevels(const float* lowerLevel, const float* upperLevel,
+            unsigned int idx0, unsigned int idx1, float frac) const noexcept;
+    forcedinline void advancePhase(float noiseFactor) noexcept;
+    /**
+     * @brief The SIMD part of processMorph(), without glide
+     * @return The number of samples rendered, a multiple of the register size
+     */
+    int processMorphSIMD(const WavetableBank& bank, const float* position, float gain,
+            float* output, const float* noise, int numSamples) noexcept;
+    /**
+     * @brief Select the mipmap levels to read and their crossfade amount from
+     * the current table delta
+     */
+    void updateMipmapLevel() noexcept;
 
 //==============================================================================
     const juce::AudioSampleBuffer&          m_wavetable;
-    NoiseGenerator&                         r_noiseGenerator;
+    NoiseGenerator                          m_noiseGenerator;
     SmoothedFrequency                       m_frequency;
     float                                   m_currentIndex;
     float                                   m_tableDelta;
+    const float*                            m_lowerLevel;
+    const float*                            m_upperLevel;
+    int                                     m_lowerLevelIndex;
+    int                                     m_upperLevelIndex;
+    float                                   m_levelFrac;
     float                                   m_tableSizeOverSampleRate;
     float                                   m_sampleRate;
     float                                   m_glide;
+    juce::AudioBuffer<float>                m_noiseFactors;
 };
 
 } // namespace engine
@@ -0,0 +1,59 @@
+/*
+  ==============================================================================
+
+    ParameterRamp.cpp
+    Created: 17 Oct 2026 10:05:18pm
+    Author:  maxime
+
+  ==============================================================================
+*/
+
+#include "ParameterRamp.h"
+
+namespace engine
+{
+
+ParameterRamp::ParameterRamp(const control::ParameterSnapshot& parameters,
+        control::ParameterSnapshot::Index index, bool useRatio)
+    : r_parameters(parameters),
+      m_index(index),
+      m_useRatio(useRatio),
+      m_smoothedValue(),
+      m_ramp()
+{
+    m_smoothedValue.setCurrentAndTargetValue(readTarget());
+}
+
+//==============================================================================
+void ParameterRamp::prepare(double sampleRate, int blockSize)
+{
+    jassert(blockSize >= 0);
+    m_smoothedValue.reset(sampleRate, RAMP_LENGTH_S);
+    m_ramp.setSize(1, juce::jmax(blockSize, 1));
+    reset();
+}
+
+void ParameterRamp::reset() noexcept
+{
+    m_smoothedValue.setCurrentAndTargetValue(readTarget());
+}
+
+void ParameterRamp::updateTarget(float factor) noexcept
+{
+    m_smoothedValue.setTargetValue(readTarget() * factor);
+}
+
+const float* ParameterRamp::getNextRamp(int numSamples) noexcept
+{
+    jassert(numSamples <= m_ramp.getNumSamples());
+    auto* ramp = m_ramp.getWritePointer(0);
+    m_smoothedValue.fillRamp(ramp, numSamples);
+    return ramp;
+}
+
+float ParameterRamp::readTarget() const noexcept
+{
+    return m_useRatio ? r_parameters.getRatio(m_index) : r_parameters.getValue(m_index);
+}
+
+} // namespace engine
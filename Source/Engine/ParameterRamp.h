@@ -0,0 +1,87 @@
+/*
+  ==============================================================================
+
+    ParameterRamp.h
+    Created: 17 Oct 2026 10:05:18pm
+    Author:  maxime
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "Control/ParameterSnapshot.h"
+#include "Utils/CustomSmoothValue.h"
+
+namespace engine
+{
+
+/**
+ * @class engine::ParameterRamp
+ * @brief Smooths one parameter of the snapshot, to avoid the zipper noise of
+ * its discrete values
+ * 
+ * Each block the target is read from the snapshot, and the ramp from the
+ * previous value is written into a per block buffer, or read sample by sample
+ * with getNextValue(). The ramp always lasts RAMP_LENGTH_S, so the parameter
+ * moves smoothly whatever the block size.
+ */
+class ParameterRamp
+{
+public:
+    static constexpr double RAMP_LENGTH_S = 0.02;
+
+    /**
+     * @param parameters The snapshot to read the target from
+     * @param index      The parameter to smooth
+     * @param useRatio   Smooth the unscaled ratio of the parameter instead of
+     * its value
+     */
+    ParameterRamp(const control::ParameterSnapshot& parameters,
+            control::ParameterSnapshot::Index index, bool useRatio = false);
+
+//==============================================================================
+    /**
+     * @brief Set the ramp length and allocate the ramp buffer
+     * 
+     * @param sampleRate The sample rate
+     * @param blockSize  The maximum number of samples of getNextRamp(), 0 when
+     * only getNextValue() is used
+     */
+    void prepare(double sampleRate, int blockSize);
+    /**
+     * @brief Jump to the current value of the parameter
+     */
+    void reset() noexcept;
+
+    /**
+     * @brief Read the new target from the snapshot, called once per block
+     * 
+     * @param factor A factor applied to the target, the noise for example
+     */
+    void updateTarget(float factor = 1.f) noexcept;
+    /**
+     * @brief Compute the next numSamples values of the ramp
+     * 
+     * @return The ramp, valid until the next call
+     */
+    const float* getNextRamp(int numSamples) noexcept;
+    forcedinline float getNextValue() noexcept { return m_smoothedValue.getNextValue(); }
+
+    bool isSmoothing() const noexcept { return m_smoothedValue.isSmoothing(); }
+    float getTargetValue() const noexcept { return m_smoothedValue.getTargetValue(); }
+
+private:
+    float readTarget() const noexcept;
+
+//==============================================================================
+    const control::ParameterSnapshot&       r_parameters;
+    control::ParameterSnapshot::Index       m_index;
+    bool                                    m_useRatio;
+    utils::CustomSmoothedValue<float>       m_smoothedValue;
+    juce::AudioBuffer<float>                m_ramp;
+};
+
+} // namespace engine
@@ -14,6 +14,7 @@ namespace engine
 {
 
 SignalBus::SignalBus()
+    : m_modulationBuffers(SignalId::MAX, 0)
 {
     for (auto id = 0; id < SignalBus::SignalId::MAX; ++id)
     {
@@ -22,5 +23,11 @@ SignalBus::SignalBus()
 }
 
 //==============================================================================
+void SignalBus::prepare(int blockSize)
+{
+    m_modulationBuffers.setSize(SignalId::MAX, blockSize);
+    m_modulationBuffers.clear();
+}
+
 
 } // namespace engine
\ No newline at end of file
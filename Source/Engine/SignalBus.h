@@ -25,6 +25,11 @@ namespace engine
  * 
  * To add a new value to the bus, add a new value to the SignalBugs::SignalId 
  * enum and use it as a key
+ * 
+ * Each signal is available both as a single value per block, and as a
+ * modulation buffer holding one value per sample of the current block. The
+ * modulation buffers are written and read by the audio thread only, the
+ * producer must write every sample of the block before the consumers run.
  */
 class SignalBus
 {
@@ -47,6 +52,13 @@ public:
 //==============================================================================
     SignalBus();
 
+    /**
+     * @brief Allocate the modulation buffers and clear them
+     * 
+     * @param blockSize The maximum number of samples per block
+     */
+    void prepare(int blockSize);
+
 //==============================================================================
     /**
      * @brief Atomically reads the signal from the bus
@@ -78,9 +90,40 @@ public:
         }
     };
 
+//==============================================================================
+    /**
+     * @brief Get the modulation buffer of a signal to write into it
+     * 
+     * @param voltageId The id of the signal to write, must be valid
+     * @return float* The first sample of the modulation buffer
+     */
+    forcedinline float* getModulationWritePointer(SignalId voltageId) noexcept
+    {
+        jassert(voltageId >= 0 && voltageId < SignalId::MAX);
+        return m_modulationBuffers.getWritePointer(voltageId);
+    }
+
+    /**
+     * @brief Get the modulation buffer of a signal to read it
+     * 
+     * @param voltageId The id of the signal to read, must be valid
+     * @return const float* The first sample of the modulation buffer
+     */
+    forcedinline const float* getModulationReadPointer(SignalId voltageId) const noexcept
+    {
+        jassert(voltageId >= 0 && voltageId < SignalId::MAX);
+        return m_modulationBuffers.getReadPointer(voltageId);
+    }
+
+    /**
+     * @brief The number of samples of the modulation buffers
+     */
+    int getModulationBufferSize() const noexcept { return m_modulationBuffers.getNumSamples(); }
+
 private:
 //==============================================================================
     juce::Atomic<float>                      m_voltageArray[MAX];
+    juce::AudioBuffer<float>                 m_modulationBuffers;
 };
 
 } //namespace engine
\ No newline at end of file
@@ -12,13 +12,15 @@
 
 #include "Utils/Utils.h"
 #include "Engine/Oscillators/DualOscillator.h"
+#include "Utils/Parameters.h"
 
 namespace engine {
 
 Voice::Voice(Bindings bindings)
     : m_ampEnvelope(bindings),
       m_accEnvelope(bindings),
-      m_osc(std::make_shared<DualOscillator>(bindings)),
+      m_osc(std::make_shared<DualOscillator>(bindings, parameters::values::ANALYTIC_OSCILLATOR
+              ? DualOscillator::Kernel::analytic : DualOscillator::Kernel::wavetableSIMD)),
       m_noteStarted(false)
 {
     /// Nothing to do here
@@ -70,7 +72,8 @@ void Voice::controllerMoved(int controllerNumber, int newValue)
 void Voice::renderNextBlock(juce::AudioBuffer<float>& outputBuffer, 
                                      int startSample, int numSamples)
 {
-    outputBuffer.clear();
+    // The synth can split a block at each note, so we only own this range
+    outputBuffer.clear(startSample, numSamples);
 
     if (m_noteStarted.get() || m_ampEnvelope.isActive())
     {
@@ -88,8 +91,12 @@ void Voice::renderNextBlock(juce::AudioBuffer<float>& outputBuffer,
             m_noteStarted.set(false);
         }
     }
+    else
+    {
+        m_ampEnvelope.writeIdleModulation(startSample, numSamples);
+    }
 
-    m_accEnvelope.nextValue(numSamples);
+    m_accEnvelope.nextValue(startSample, numSamples);
 }
 
 void Voice::setCurrentPlaybackSampleRate(double newRate)
@@ -0,0 +1,619 @@
+/*
+  ==============================================================================
+
+    VoicePool.cpp
+    Created: 17 Oct 2026 7:24:10pm
+    Author:  maxime
+
+  ==============================================================================
+*/
+
+#include "VoicePool.h"
+
+#include <cmath>
+#include <limits>
+
+#include "Engine/Envelopes/Utils.h"
+#include "Engine/SignalBus.h"
+
+#include "Utils/Utils.h"
+
+namespace engine
+{
+
+// Same values than engine::DualOscillator and engine::VCAEnvelope
+constexpr float  WAVEFORM_GAIN = 0.5f;
+constexpr double ATTACK_RATIO = 0.3;
+constexpr double DECAY_RATIO = 0.0001;
+constexpr double RELEASE_RATIO = 0.0001;
+// Cutoff of the voices pitch drift, drawn once per block
+constexpr double DRIFT_CUTOFF_HZ = 4.;
+// An envelope level is within [0; 1], so this target is never reached
+constexpr float  UNREACHABLE_TARGET = 2.f;
+// Below this distance to their target, the envelopes are checked every sample
+constexpr int    MIN_PREDICTED_SAMPLES = 32;
+
+// Indexes of the ADSR values cached by the pool
+enum AdsrValue {ATTACK_VALUE, DECAY_VALUE, SUSTAIN_VALUE, RELEASE_VALUE};
+
+VoicePool::VoicePool(int numVoices, Bindings bindings)
+    : r_wavetables(bindings.r_wavetables),
+      m_accEnvelope(bindings),
+      m_noiseGenerator(bindings.r_noiseGenerator.fork(NoiseGenerator::VOICE_POOL)),
+      r_signalBus(bindings.r_signalBus),
+      r_parameters(bindings.r_parameters),
+      m_index(),
+      m_delta(),
+      m_targetDelta(),
+      m_glideFactor(),
+      m_glideSamplesLeft(),
+      m_drift(),
+      m_driftGenerators(),
+      m_lowerFrameLevel(),
+      m_upperFrameLevel(),
+      m_voiceSamples(),
+      m_envLevel(),
+      m_envBase(),
+      m_envCoeff(),
+      m_envTarget(),
+      m_envDirection(),
+      m_stage(),
+      m_note(),
+      m_noteOrder(),
+      m_noteCounter(0),
+      m_lastNoteDelta(0.f),
+      m_adsrValues(),
+      m_attackCoeff(0.f),
+      m_attackBase(0.f),
+      m_decayCoeff(0.f),
+      m_decayBase(0.f),
+      m_releaseCoeff(0.f),
+      m_releaseBase(0.f),
+      m_morph(r_wavetables.getMorph(0.f)),
+      m_lowerFrameGain(0.f),
+      m_upperFrameGain(0.f),
+      m_numVoices(numVoices),
+      m_voiceGain(WAVEFORM_GAIN / std::sqrt(float(numVoices))),
+      m_sampleRate(0.),
+      m_tableSizeOverSampleRate(0.f)
+{
+    jassert(numVoices > 0 && numVoices <= MAX_VOICES);
+
+    reset();
+}
+
+//==============================================================================
+void VoicePool::prepare(double sampleRate, int blockSize)
+{
+    jassert(sampleRate > 0.);
+    jassert(blockSize > 0);
+
+    m_sampleRate = sampleRate;
+
+    for (auto& drift : m_driftGenerators)
+    {
+        drift.prepare(sampleRate / blockSize, DRIFT_CUTOFF_HZ);
+    }
+
+    m_tableSizeOverSampleRate = float(WavetableBank::TABLE_SIZE / sampleRate);
+    m_accEnvelope.setSampleRate(sampleRate);
+
+    // Force the computation of the envelope coefficients
+    m_adsrValues.fill(-1.f);
+    updateEnvelopeCoefficients();
+    reset();
+}
+
+void VoicePool::reset()
+{
+    for (auto voice = 0; voice < MAX_VOICES; ++voice)
+    {
+        m_index[voice] = 0.f;
+        m_delta[voice] = 0.f;
+        m_targetDelta[voice] = 0.f;
+        m_glideFactor[voice] = 1.f;
+        m_glideSamplesLeft[voice] = 0;
+        m_drift[voice] = 1.f;
+        m_driftGenerators[voice].reset();
+        m_lowerFrameLevel[voice] = r_wavetables.getLevel(m_morph.m_lowerFrame, 0);
+        m_upperFrameLevel[voice] = r_wavetables.getLevel(m_morph.m_upperFrame, 0);
+        m_voiceSamples[voice] = 0.f;
+        m_envLevel[voice] = 0.f;
+        m_note[voice] = -1;
+        m_noteOrder[voice] = 0;
+        setStage(voice, Stage::idle);
+    }
+
+    m_noteCounter = 0;
+    m_lastNoteDelta = 0.f;
+    m_accEnvelope.reset();
+}
+
+void VoicePool::renderNextBlock(juce::AudioBuffer<float>& outputBuffer,
+        const juce::MidiBuffer& midiBuffer, int startSample, int numSamples) noexcept
+{
+    jassert(m_sampleRate > 0.);
+    jassert(outputBuffer.getNumChannels() == 1);
+
+    auto* output = outputBuffer.getWritePointer(0);
+    auto position = startSample;
+    auto endSample = startSample + numSamples;
+
+    updateBlockParameters();
+
+    // Render up to each note message, then handle it
+    for (const auto metadata : midiBuffer)
+    {
+        auto eventPosition = juce::jlimit(startSample, endSample, metadata.samplePosition);
+
+        if (eventPosition > position)
+        {
+            renderRange(output, position, eventPosition - position);
+            position = eventPosition;
+        }
+
+        handleMidiEvent(metadata.getMessage());
+    }
+
+    if (position < endSample)
+    {
+        renderRange(output, position, endSample - position);
+    }
+}
+
+int VoicePool::getNumActiveVoices() const noexcept
+{
+    auto numActive = 0;
+
+    for (auto voice = 0; voice < m_numVoices; ++voice)
+    {
+        if (m_stage[voice] != Stage::idle)
+        {
+            ++numActive;
+        }
+    }
+
+    return numActive;
+}
+
+//==============================================================================
+void VoicePool::handleMidiEvent(const juce::MidiMessage& msg) noexcept
+{
+    if (msg.isNoteOn())
+    {
+        noteOn(msg.getNoteNumber(), msg.getFloatVelocity());
+    }
+    else if (msg.isNoteOff())
+    {
+        noteOff(msg.getNoteNumber());
+    }
+    else if (msg.isAllNotesOff() || msg.isAllSoundOff())
+    {
+        for (auto voice = 0; voice < m_numVoices; ++voice)
+        {
+            if (m_stage[voice] != Stage::idle)
+            {
+                setStage(voice, Stage::release);
+            }
+        }
+
+        m_accEnvelope.noteOff();
+    }
+}
+
+void VoicePool::noteOn(int midiNoteNumber, float velocity) noexcept
+{
+    auto voice = findVoiceToPlay(midiNoteNumber);
+    auto targetDelta = float(juce::MidiMessage::getMidiNoteInHertz(midiNoteNumber))
+            * m_tableSizeOverSampleRate;
+    auto glideSamples = int(r_parameters.getValue(control::ParameterSnapshot::GLIDE) * m_sampleRate);
+
+    // Like in the mono mode, the new note glides from the last one as long as
+    // some voices are still playing
+    if (glideSamples > 0 && m_lastNoteDelta > 0.f && getNumActiveVoices() > 0)
+    {
+        m_delta[voice] = m_lastNoteDelta;
+        m_glideFactor[voice] = std::pow(targetDelta / m_lastNoteDelta, 1.f / float(glideSamples));
+        m_glideSamplesLeft[voice] = glideSamples;
+    }
+    else
+    {
+        m_delta[voice] = targetDelta;
+        m_glideFactor[voice] = 1.f;
+        m_glideSamplesLeft[voice] = 0;
+    }
+
+    if (m_stage[voice] == Stage::idle)
+    {
+        m_index[voice] = 0.f;
+        m_envLevel[voice] = 0.f;
+    }
+
+    m_targetDelta[voice] = targetDelta;
+    m_note[voice] = midiNoteNumber;
+    m_noteOrder[voice] = ++m_noteCounter;
+    m_lastNoteDelta = targetDelta;
+    setStage(voice, Stage::attack);
+    updateMipmapLevel(voice);
+
+    m_accEnvelope.noteOn(velocity);
+}
+
+void VoicePool::noteOff(int midiNoteNumber) noexcept
+{
+    auto noteHeld = false;
+
+    for (auto voice = 0; voice < m_numVoices; ++voice)
+    {
+        if (m_stage[voice] == Stage::idle || m_stage[voice] == Stage::release)
+        {
+            continue;
+        }
+
+        if (m_note[voice] == midiNoteNumber)
+        {
+            setStage(voice, Stage::release);
+        }
+        else
+        {
+            noteHeld = true;
+        }
+    }
+
+    // The accent envelope is shared, it only decays once every note is off
+    if (! noteHeld)
+    {
+        m_accEnvelope.noteOff();
+    }
+}
+
+int VoicePool::findVoiceToPlay(int midiNoteNumber) const noexcept
+{
+    // A playing note is retriggered on its own voice
+    for (auto voice = 0; voice < m_numVoices; ++voice)
+    {
+        if (m_stage[voice] != Stage::idle && m_note[voice] == midiNoteNumber)
+        {
+            return voice;
+        }
+    }
+
+    for (auto voice = 0; voice < m_numVoices; ++voice)
+    {
+        if (m_stage[voice] == Stage::idle)
+        {
+            return voice;
+        }
+    }
+
+    // Every voice is busy, we steal the oldest note
+    auto oldest = 0;
+
+    for (auto voice = 1; voice < m_numVoices; ++voice)
+    {
+        if (m_noteOrder[voice] < m_noteOrder[oldest])
+        {
+            oldest = voice;
+        }
+    }
+
+    return oldest;
+}
+
+//==============================================================================
+void VoicePool::updateBlockParameters() noexcept
+{
+    updateEnvelopeCoefficients();
+
+    // We get the controllable values for the whole block, the ratio selects
+    // the two frames to morph between
+    auto ratio = r_parameters.getValue(control::ParameterSnapshot::WAVEFORM_RATIO)
+            * m_noiseGenerator.getNoiseFactor();
+    m_morph = r_wavetables.getMorph(ratio);
+    m_lowerFrameGain = (1.f - m_morph.m_frac) * m_voiceGain;
+    m_upperFrameGain = m_morph.m_frac * m_voiceGain;
+
+    for (auto voice = 0; voice < m_numVoices; ++voice)
+    {
+        // Each voice drifts smoothly on its own, once per block
+        m_drift[voice] = m_driftGenerators[voice].getNextDriftFactor(m_noiseGenerator);
+
+        // Reload the stage coefficients, in case the parameters changed
+        setStage(voice, m_stage[voice]);
+        updateMipmapLevel(voice);
+    }
+}
+
+void VoicePool::updateEnvelopeCoefficients() noexcept
+{
+    auto values = std::array<float, 4>{
+        r_parameters.getValue(control::ParameterSnapshot::ATTACK),
+        r_parameters.getValue(control::ParameterSnapshot::DECAY),
+        r_parameters.getValue(control::ParameterSnapshot::SUSTAIN),
+        r_parameters.getValue(control::ParameterSnapshot::RELEASE)};
+
+    // Computing the coefficients is expensive, and they rarely change
+    if (values == m_adsrValues)
+    {
+        return;
+    }
+
+    m_adsrValues = values;
+
+    // Same computation than engine::VCAEnvelope
+    auto attackNumSamples = int(values[ATTACK_VALUE] * m_sampleRate);
+    auto decayNumSamples = int(values[DECAY_VALUE] * m_sampleRate);
+    auto releaseNumSamples = int(values[RELEASE_VALUE] * m_sampleRate);
+
+    m_attackCoeff = float(computeExpEnvCoeff(attackNumSamples, ATTACK_RATIO));
+    m_attackBase = float((1.0 + ATTACK_RATIO) * (1.0 - m_attackCoeff));
+    m_decayCoeff = float(computeExpEnvCoeff(decayNumSamples, DECAY_RATIO));
+    m_decayBase = float((values[SUSTAIN_VALUE] - DECAY_RATIO) * (1.0 - m_decayCoeff));
+    m_releaseCoeff = float(computeExpEnvCoeff(releaseNumSamples, RELEASE_RATIO));
+    m_releaseBase = float(- RELEASE_RATIO * (1.0 - m_releaseCoeff));
+}
+
+void VoicePool::updateMipmapLevel(int voice) noexcept
+{
+    // A single level per voice, the mipmap has an octave of headroom so it
+    // stays alias free up to twice the delta the level was picked for. We use
+    // the highest delta in case the voice is gliding up
+    auto delta = juce::jmax(m_delta[voice], m_targetDelta[voice], 1.f);
+    auto level = juce::jlimit(0, r_wavetables.getNumLevels() - 1, int(std::log2(delta)));
+
+    m_lowerFrameLevel[voice] = r_wavetables.getLevel(m_morph.m_lowerFrame, level);
+    m_upperFrameLevel[voice] = r_wavetables.getLevel(m_morph.m_upperFrame, level);
+}
+
+void VoicePool::setStage(int voice, Stage stage) noexcept
+{
+    m_stage[voice] = stage;
+
+    switch (stage)
+    {
+        case Stage::idle:
+            m_envBase[voice] = 0.f;
+            m_envCoeff[voice] = 0.f;
+            m_envTarget[voice] = UNREACHABLE_TARGET;
+            m_envDirection[voice] = 1.f;
+            break;
+
+        case Stage::attack:
+            m_envBase[voice] = m_attackBase;
+            m_envCoeff[voice] = m_attackCoeff;
+            m_envTarget[voice] = 1.f;
+            m_envDirection[voice] = 1.f;
+            break;
+
+        case Stage::decay:
+            m_envBase[voice] = m_decayBase;
+            m_envCoeff[voice] = m_decayCoeff;
+            m_envTarget[voice] = m_adsrValues[SUSTAIN_VALUE];
+            m_envDirection[voice] = -1.f;
+            break;
+
+        case Stage::sustain:
+            m_envBase[voice] = m_adsrValues[SUSTAIN_VALUE];
+            m_envCoeff[voice] = 0.f;
+            m_envTarget[voice] = UNREACHABLE_TARGET;
+            m_envDirection[voice] = 1.f;
+            break;
+
+        case Stage::release:
+            m_envBase[voice] = m_releaseBase;
+            m_envCoeff[voice] = m_releaseCoeff;
+            m_envTarget[voice] = 0.f;
+            m_envDirection[voice] = -1.f;
+            break;
+    }
+}
+
+void VoicePool::advanceStage(int voice) noexcept
+{
+    switch (m_stage[voice])
+    {
+        case Stage::attack:
+            setStage(voice, Stage::decay);
+            break;
+
+        case Stage::decay:
+            setStage(voice, Stage::sustain);
+            break;
+
+        case Stage::release:
+            setStage(voice, Stage::idle);
+            break;
+
+        default:
+            // Idle and sustain never reach their target
+            jassertfalse;
+            break;
+    }
+}
+
+int VoicePool::getSamplesToNextEvent() const noexcept
+{
+    auto numSamples = std::numeric_limits<int>::max();
+
+    for (auto voice = 0; voice < m_numVoices; ++voice)
+    {
+        if (m_stage[voice] == Stage::idle)
+        {
+            continue;
+        }
+
+        numSamples = juce::jmin(numSamples, getSamplesToTarget(voice));
+
+        if (m_glideSamplesLeft[voice] > 0)
+        {
+            numSamples = juce::jmin(numSamples, m_glideSamplesLeft[voice]);
+        }
+    }
+
+    return numSamples;
+}
+
+int VoicePool::getSamplesToTarget(int voice) const noexcept
+{
+    constexpr auto never = std::numeric_limits<int>::max();
+    auto target = m_envTarget[voice];
+    auto direction = m_envDirection[voice];
+
+    // The next level is already beyond the target
+    if ((m_envBase[voice] + m_envLevel[voice] * m_envCoeff[voice] - target) * direction >= 0.f)
+    {
+        return 1;
+    }
+
+    // The levels converge towards base / (1 - coeff), the distance to it being
+    // multiplied by coeff at each sample. The coeff is close to 1 for the long
+    // stages, so this is computed in double
+    auto coeff = double(m_envCoeff[voice]);
+
+    if (coeff <= 0. || coeff >= 1.)
+    {
+        return never;
+    }
+
+    auto limit = m_envBase[voice] / (1. - coeff);
+
+    if ((limit - target) * direction <= 0.)
+    {
+        return never;
+    }
+
+    auto ratio = (target - limit) / (m_envLevel[voice] - limit);
+
+    if (! std::isfinite(ratio) || ratio <= 0.)
+    {
+        return never;
+    }
+
+    auto numSamples = std::log(ratio) / std::log(coeff);
+
+    if (numSamples >= double(never))
+    {
+        return never;
+    }
+
+    // The float levels drift from the equation, so we stop early and the last
+    // samples are checked one by one : the stage changes at the exact sample
+    auto samples = int(numSamples);
+    return samples > MIN_PREDICTED_SAMPLES ? samples - samples / 4 : 1;
+}
+
+//==============================================================================
+void VoicePool::renderRange(float* output, int startSample, int numSamples) noexcept
+{
+    jassert(startSample + numSamples <= r_signalBus.getModulationBufferSize());
+
+    auto* modulation = r_signalBus.getModulationWritePointer(SignalBus::SignalId::VEG);
+    auto envSum = 0.f;
+    auto position = startSample;
+    auto endSample = startSample + numSamples;
+
+    while (position < endSample)
+    {
+        auto chunkSize = juce::jmin(endSample - position, getSamplesToNextEvent());
+
+        envSum += renderChunk(output + position, modulation + position, chunkSize);
+        updateVoiceStates(chunkSize);
+        position += chunkSize;
+    }
+
+    // We send the mean value to others units, like engine::VCAEnvelope
+    r_signalBus.updateSignal(SignalBus::SignalId::VEG, envSum / float(numSamples));
+    m_accEnvelope.nextValue(startSample, numSamples);
+}
+
+float VoicePool::renderChunk(float* output, float* modulation, int numSamples) noexcept
+{
+    auto tableSize = float(WavetableBank::TABLE_SIZE);
+    auto tableMask = WavetableBank::TABLE_SIZE - 1;
+    auto envSum = 0.f;
+
+    for (auto i = 0; i < numSamples; ++i)
+    {
+        // Envelopes, held at their target until the stage changes after the
+        // chunk. The idle voices stay at 0
+        for (auto voice = 0; voice < MAX_VOICES; ++voice)
+        {
+            auto direction = m_envDirection[voice];
+            auto env = m_envBase[voice] + m_envLevel[voice] * m_envCoeff[voice];
+            m_envLevel[voice] = juce::jmin(env * direction, m_envTarget[voice] * direction)
+                    * direction;
+        }
+
+        // Oscillators, both frames are read at the same position. The table
+        // reads are gathers, they stay scalar
+        for (auto voice = 0; voice < m_numVoices; ++voice)
+        {
+            auto index = m_index[voice];
+            auto idx0 = int(index);
+            auto idx1 = (idx0 + 1) & tableMask;
+            auto frac = index - float(idx0);
+
+            auto value0 = m_lowerFrameGain * m_lowerFrameLevel[voice][idx0]
+                    + m_upperFrameGain * m_upperFrameLevel[voice][idx0];
+            auto value1 = m_lowerFrameGain * m_lowerFrameLevel[voice][idx1]
+                    + m_upperFrameGain * m_upperFrameLevel[voice][idx1];
+
+            m_voiceSamples[voice] = m_envLevel[voice] * (value0 + frac * (value1 - value0));
+        }
+
+        // Phases, the voices which do not glide have a glide factor of 1
+        for (auto voice = 0; voice < MAX_VOICES; ++voice)
+        {
+            m_delta[voice] *= m_glideFactor[voice];
+            auto index = m_index[voice] + m_delta[voice] * m_drift[voice];
+            m_index[voice] = index >= tableSize ? index - tableSize : index;
+        }
+
+        auto sample = 0.f;
+        auto envMax = 0.f;
+
+        for (auto voice = 0; voice < m_numVoices; ++voice)
+        {
+            sample += m_voiceSamples[voice];
+            envMax = juce::jmax(envMax, m_envLevel[voice]);
+        }
+
+        output[i] = sample;
+        modulation[i] = envMax;
+        envSum += envMax;
+    }
+
+    return envSum;
+}
+
+void VoicePool::updateVoiceStates(int numSamples) noexcept
+{
+    for (auto voice = 0; voice < m_numVoices; ++voice)
+    {
+        if (m_stage[voice] == Stage::idle)
+        {
+            continue;
+        }
+
+        if ((m_envLevel[voice] - m_envTarget[voice]) * m_envDirection[voice] >= 0.f)
+        {
+            advanceStage(voice);
+        }
+
+        // The last step of the glide lands exactly on the target
+        if (m_glideSamplesLeft[voice] > 0)
+        {
+            jassert(numSamples <= m_glideSamplesLeft[voice]);
+            m_glideSamplesLeft[voice] -= numSamples;
+
+            if (m_glideSamplesLeft[voice] <= 0)
+            {
+                m_glideSamplesLeft[voice] = 0;
+                m_glideFactor[voice] = 1.f;
+                m_delta[voice] = m_targetDelta[voice];
+            }
+        }
+    }
+}
+
+} // namespace engine
@@ -0,0 +1,171 @@
+/*
+  ==============================================================================
+
+    VoicePool.h
+    Created: 17 Oct 2026 7:24:10pm
+    Author:  maxime
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+
+#include <JuceHeader.h>
+
+#include "Engine/Envelopes/AccentEnvelope.h"
+#include "Engine/Binding.h"
+#include "Engine/Oscillators/WavetableBank.h"
+
+namespace engine
+{
+
+/**
+ * @class engine::VoicePool
+ * @brief The paraphonic mode of the synth, playing up to MAX_VOICES notes at
+ * once through the shared filter
+ *
+ * Unlike the mono mode, which renders a single engine::Voice through a
+ * juce::Synthesiser, the pool does not hold any voice object. The state of
+ * every voice (table index and delta, glide, envelope stage and level) is
+ * stored in structure of arrays, and all the voices are rendered together,
+ * without any virtual call.
+ *
+ * The block is rendered in chunks which end at the next envelope stage change
+ * or glide end of a voice, predicted from the envelope equation. Within a
+ * chunk, the envelopes, the phases and the mix are computed by branchless
+ * loops across the voices, the idle ones being muted by their null envelope.
+ * Only the table reads stay scalar. The stages and the glides are updated
+ * between the chunks.
+ *
+ * The voices share the waveform ratio, the glide and the ADSR parameters. The
+ * accent envelope is shared too, and retriggered by every note. The VEG
+ * modulation signal is the max of the voices envelopes.
+ *
+ * When all the voices are busy, the oldest note is stolen.
+ */
+class VoicePool
+{
+public:
+    static constexpr int MAX_VOICES = 8;
+
+    /**
+     * @param numVoices The number of voices, within [1; MAX_VOICES]
+     */
+    VoicePool(int numVoices, Bindings bindings);
+
+//==============================================================================
+    void prepare(double sampleRate, int blockSize);
+    /**
+     * @brief Stop every voice, not the parameters
+     */
+    void reset();
+
+    /**
+     * @brief Render the voices into the first channel of the buffer
+     *
+     * Same behaviour than juce::Synthesiser::renderNextBlock, the block is
+     * split at the position of each note message.
+     */
+    void renderNextBlock(juce::AudioBuffer<float>& outputBuffer,
+            const juce::MidiBuffer& midiBuffer, int startSample, int numSamples) noexcept;
+
+//==============================================================================
+    int getNumVoices() const noexcept { return m_numVoices; }
+    /**
+     * @brief The number of voices which are not idle
+     */
+    int getNumActiveVoices() const noexcept;
+
+private:
+    enum Stage : juce::uint8 {idle, attack, decay, sustain, release};
+
+    void handleMidiEvent(const juce::MidiMessage& msg) noexcept;
+    void noteOn(int midiNoteNumber, float velocity) noexcept;
+    void noteOff(int midiNoteNumber) noexcept;
+    int findVoiceToPlay(int midiNoteNumber) const noexcept;
+
+    void updateBlockParameters() noexcept;
+    void updateEnvelopeCoefficients() noexcept;
+    void updateMipmapLevel(int voice) noexcept;
+    void setStage(int voice, Stage stage) noexcept;
+    void advanceStage(int voice) noexcept;
+
+    /**
+     * @brief A number of samples without any stage change nor glide end, at
+     * least 1
+     */
+    int getSamplesToNextEvent() const noexcept;
+    /**
+     * @brief A number of samples the envelope of the voice can run without
+     * reaching the target of its stage, at least 1
+     */
+    int getSamplesToTarget(int voice) const noexcept;
+
+    void renderRange(float* output, int startSample, int numSamples) noexcept;
+    /**
+     * @brief Render samples without any stage change nor glide end
+     * @return The sum of the VEG modulation values
+     */
+    float renderChunk(float* output, float* modulation, int numSamples) noexcept;
+    /**
+     * @brief Update the stages and the glides after a chunk
+     */
+    void updateVoiceStates(int numSamples) noexcept;
+
+//==============================================================================
+    // Shared modules and parameters
+    const WavetableBank&                    r_wavetables;
+    AccentEnvelope                          m_accEnvelope;
+    NoiseGenerator                          m_noiseGenerator;
+    SignalBus&                              r_signalBus;
+    const control::ParameterSnapshot&       r_parameters;
+
+    // Voices oscillator state
+    std::array<float, MAX_VOICES>           m_index;
+    std::array<float, MAX_VOICES>           m_delta;
+    std::array<float, MAX_VOICES>           m_targetDelta;
+    std::array<float, MAX_VOICES>           m_glideFactor;
+    std::array<int, MAX_VOICES>             m_glideSamplesLeft;
+    std::array<float, MAX_VOICES>           m_drift;
+    std::array<NoiseDrift, MAX_VOICES>      m_driftGenerators;
+    std::array<const float*, MAX_VOICES>    m_lowerFrameLevel;
+    std::array<const float*, MAX_VOICES>    m_upperFrameLevel;
+    // The enveloped oscillator output of the current sample
+    std::array<float, MAX_VOICES>           m_voiceSamples;
+
+    // Voices envelope state, each sample computes base + level * coeff until
+    // (level - target) * direction reaches 0
+    std::array<float, MAX_VOICES>           m_envLevel;
+    std::array<float, MAX_VOICES>           m_envBase;
+    std::array<float, MAX_VOICES>           m_envCoeff;
+    std::array<float, MAX_VOICES>           m_envTarget;
+    std::array<float, MAX_VOICES>           m_envDirection;
+    std::array<Stage, MAX_VOICES>           m_stage;
+
+    // Voices allocation
+    std::array<int, MAX_VOICES>             m_note;
+    std::array<juce::uint32, MAX_VOICES>    m_noteOrder;
+    juce::uint32                            m_noteCounter;
+    float                                   m_lastNoteDelta;
+
+    // Block values
+    std::array<float, 4>                    m_adsrValues;
+    float                                   m_attackCoeff;
+    float                                   m_attackBase;
+    float                                   m_decayCoeff;
+    float                                   m_decayBase;
+    float                                   m_releaseCoeff;
+    float                                   m_releaseBase;
+    WavetableBank::Morph                    m_morph;
+    float                                   m_lowerFrameGain;
+    float                                   m_upperFrameGain;
+
+    int                                     m_numVoices;
+    float                                   m_voiceGain;
+    double                                  m_sampleRate;
+    float                                   m_tableSizeOverSampleRate;
+};
+
+} // namespace engine
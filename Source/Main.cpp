@@ -13,21 +13,57 @@
 #include <iostream>
 
 #include "Engine/Engine.h"
+#include "Engine/OfflineRenderer.h"
 #include "Control/MidiBroker.h"
 #include "Control/MidiDeviceMonitor.h"
 #include "Utils/Parameters.h"
 #include "Tests/TestRunner.h"
+#include "Benchmarks/BenchmarkRunner.h"
 
 //==============================================================================
 int main (int argc, char* argv[])
 {
-#ifndef TESTING
+#if defined(BENCHMARKING)
+    // Benchmark mode : benchmarks [output.json]
+    auto jsonFile = juce::File::getCurrentWorkingDirectory().getChildFile(
+            argc >= 2 ? argv[1] : "benchmarks.json");
+    auto result = 0;
+
+    {
+        auto benchmarkRunner = benchmarks::BenchmarkRunner();
+        auto results = benchmarkRunner.runAllBenchmarks();
+
+        if (! jsonFile.replaceWithText(juce::JSON::toString(
+                benchmarks::BenchmarkRunner::toJson(results))))
+        {
+            std::cerr << "Could not write json file : " << jsonFile.getFullPathName() << std::endl;
+            result = 1;
+        }
+    }
+
+    return result;
+#elif ! defined(TESTING)
     auto device_manager = std::make_unique<juce::AudioDeviceManager>();
     auto* messageManager = juce::MessageManager::getInstance();
     auto midiBroker = control::MidiBroker();
     auto engine = engine::RaciderryEngine(midiBroker);
     DBG("Created");
 
+    if (argc >= 4 && juce::String(argv[1]) == "--render")
+    {
+        // Offline mode : raciderry --render in.mid out.wav [samplerate] [blocksize]
+        auto cwd = juce::File::getCurrentWorkingDirectory();
+        auto sampleRate = parameters::device::PISOUND_SETUP.sampleRate;
+        auto blockSize = parameters::device::PISOUND_SETUP.bufferSize;
+
+        if (argc >= 5) { sampleRate = juce::String(argv[4]).getDoubleValue(); }
+        if (argc >= 6) { blockSize = juce::String(argv[5]).getIntValue(); }
+
+        auto renderer = engine::OfflineRenderer(engine, midiBroker);
+        return renderer.renderFile(cwd.getChildFile(argv[2]), cwd.getChildFile(argv[3]),
+                sampleRate, blockSize);
+    }
+
     sleep(1);
 
     device_manager->initialise(0, 2, nullptr, true, "", &parameters::device::PISOUND_SETUP);
@@ -59,6 +95,9 @@ int main (int argc, char* argv[])
     auto midiMonitor = control::MidiDeviceMonitor(*device_manager);
     device_manager->addMidiInputDeviceCallback("", &midiBroker);
 
+    // Print the DSP profile on SIGUSR1
+    auto profilerReporter = engine::DspProfilerReporter(engine.getProfiler());
+
     messageManager->runDispatchLoop();
 
     while(true) {
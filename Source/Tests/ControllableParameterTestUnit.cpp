@@ -222,6 +222,41 @@ public:
             expect(param.getCurrentValue() == param.getScaledValueForUnscaledRatio(unscaled_ratio));
         });
 
+        TEST("Continuous values", [=] {
+            auto param = control::ControllableParameter(
+                1.0f,
+                0.01f,
+                2.0f,
+                control::ControllableParameter::ScaleType::logarithmic
+            );
+            auto maxIdx = param.getDiscretRange() - 1;
+
+            // Halfway btw two discret values
+            auto ratio = 40.5f / maxIdx;
+            param.setDiscretValue(40);
+            auto lower = param.getCurrentValue();
+            param.setDiscretValue(41);
+            auto upper = param.getCurrentValue();
+            param.setRatio(ratio);
+
+            expectWithinAbsoluteError(param.getUnscaledRatioForCurrentValue(), ratio, 1e-6f);
+            expectWithinAbsoluteError(param.getCurrentValue(), (lower + upper) / 2.f, 1e-5f);
+            expectEquals(param.getCurrentValue(), param.getScaledValueForUnscaledRatio(ratio));
+            expect(param.getCurrentDiscretValue() == 40 || param.getCurrentDiscretValue() == 41);
+
+            // The relative movements start from the nearest discret value
+            param.setRatio(10.2f / maxIdx);
+            param.updateCurrentDiscretValue(1);
+            expectEquals(param.getCurrentDiscretValue(), 11);
+            expectEquals(param.getUnscaledRatioForCurrentValue(), 11.f / maxIdx);
+
+            // Extreme values
+            param.setRatio(0.f);
+            expectEquals(param.getCurrentValue(), 0.01f);
+            param.setRatio(1.f);
+            expectEquals(param.getCurrentValue(), 2.0f);
+        });
+
         TEST("Comparison and copy", [=] {
             auto constexpr vmin = 0.0f;
             auto constexpr vmax = 2.0f;
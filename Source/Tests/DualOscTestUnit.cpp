@@ -8,6 +8,8 @@
   ==============================================================================
 */
 
+#include <numeric>
+
 #include "Tests/CustomTestUnit.h"
 #include "Tests/Utils.h"
 #include "Tests/CallDispatcher.h"
@@ -28,7 +30,9 @@ public:
             category::engine::oscillators),
             m_noiseGen(0.05),
             m_signalBus(),
-            m_bindings{m_parameterMap, m_noiseGen, m_signalBus} {};
+            m_parameters(),
+            m_wavetables(),
+            m_bindings{m_parameterMap, m_noiseGen, m_signalBus, m_parameters, m_wavetables} {};
 
     void initialise() override
     {
@@ -38,6 +42,7 @@ public:
                 control::ControllableParameter(0.5, 0.0, 1.0);
         (*m_parameterMap)[identifiers::controls::GLIDE] = 
                 control::ControllableParameter(0.5, 0.0, 1.0);
+        m_parameters = control::ParameterSnapshot::fromParameterMap(*m_parameterMap);
     }
 
     void shutdown() override
@@ -61,22 +66,135 @@ public:
     });
 
     TEST("Test multiple processing context", [=] {
-        auto osc = engine::DualOscillator(m_bindings);
+        using Kernel = engine::DualOscillator::Kernel;
 
         float samplerates[] = {44100, 48000, 96000, 192000};
         int blockSizes[] = {128, 256, 512, 1024, 2048};
+        Kernel kernels[] = {Kernel::wavetable, Kernel::wavetableSIMD, Kernel::analytic};
         auto buffer = juce::AudioBuffer<float>(1, 2048);
         
+        for (auto& kernel : kernels)
+        {
+            auto osc = engine::DualOscillator(m_bindings, kernel);
+
+            for (auto& samplerate : samplerates)
+            {
+                for (auto& blockSize : blockSizes)
+                {
+                    osc.prepare(samplerate, blockSize);
+                    osc.process(buffer, 0, blockSize);
+                    osc.process(buffer, 0, blockSize);
+                    osc.process(buffer, 0, blockSize);
+                    osc.reset();
+                }
+            }
+        }
+    });
 
-        for (auto& samplerate : samplerates)
+    TEST("Analytic kernel without wavetables", [=] {
+        // The analytic kernel must never read the bank of the low memory builds
+        auto emptyBank = engine::WavetableBank(false);
+        auto bindings = engine::Bindings{m_parameterMap, m_noiseGen, m_signalBus,
+                m_parameters, emptyBank};
+        auto buffer = juce::AudioBuffer<float>(1, BLOCK_SIZE);
+        expectEquals(emptyBank.getNumFrames(), 0);
+
+        auto osc = engine::DualOscillator(bindings, engine::DualOscillator::Kernel::analytic);
+        osc.prepare(48000, BLOCK_SIZE);
+        osc.setFrequency(440.f, true);
+        buffer.clear();
+        osc.process(buffer, 0, BLOCK_SIZE);
+
+        for (auto i = 0; i < BLOCK_SIZE; ++i)
         {
-            for (auto& blockSize : blockSizes)
+            expect(std::isfinite(buffer.getSample(0, i)));
+        }
+
+        expect(buffer.getMagnitude(0, BLOCK_SIZE) > 0.f);
+    });
+
+    TEST("PolyBLEP", [=] {
+        auto osc = engine::PolyBlepOscillator(m_bindings);
+        auto ratio = std::vector<float>(BLOCK_SIZE);
+        auto output = std::vector<float>(BLOCK_SIZE);
+
+        // The residual only lives within one sample of the step
+        expectEquals(engine::PolyBlepOscillator::polyBlep(0.5f, 0.01f), 0.f);
+        expectWithinAbsoluteError(engine::PolyBlepOscillator::polyBlep(0.f, 0.01f), -1.f, 1e-6f);
+        expectWithinAbsoluteError(engine::PolyBlepOscillator::polyBlep(0.999999f, 0.01f), 1.f, 1e-3f);
+
+        osc.prepare(48000, BLOCK_SIZE);
+        osc.setFrequency(440.f, true);
+
+        // From the saw to the square, the output stays finite and bounded
+        for (auto r : {0.f, 0.5f, 1.f})
+        {
+            std::fill(ratio.begin(), ratio.end(), r);
+            osc.processMorph(ratio.data(), 1.f, output.data(), BLOCK_SIZE);
+
+            for (auto& sample : output)
+            {
+                expect(std::isfinite(sample));
+                expect(std::abs(sample) <= 1.1f);
+            }
+        }
+
+        // The square spends as much time up than down
+        auto mean = std::accumulate(output.begin(), output.end(), 0.f) / BLOCK_SIZE;
+        expectWithinAbsoluteError(mean, 0.f, 0.05f);
+    });
+
+    TEST("Unison", [=] {
+        auto positions = std::vector<float>(BLOCK_SIZE, 0.f);
+        auto output = std::vector<float>(BLOCK_SIZE);
+
+        for (auto analytic : {false, true})
+        {
+            auto stack = engine::UnisonStack(m_bindings, analytic);
+            stack.prepare(48000, BLOCK_SIZE);
+            stack.setFrequency(440.f, true);
+
+            // A single voice without sub leaves the output untouched
+            stack.setVoices(1, 20.f, 0.f);
+            std::fill(output.begin(), output.end(), 0.f);
+            stack.process(m_wavetables, positions.data(), 1.f, output.data(), BLOCK_SIZE);
+            expect(! stack.isActive());
+            expectEquals(stack.getVoiceGain(), 1.f);
+            expect(std::all_of(output.begin(), output.end(), [](float s) { return s == 0.f; }));
+
+            // The sub alone is a saw one octave down : one falling edge per period
+            stack.setVoices(1, 20.f, 1.f);
+            stack.process(m_wavetables, positions.data(), 1.f, output.data(), BLOCK_SIZE);
+            auto numPeriods = 0;
+
+            for (auto i = 1; i < BLOCK_SIZE; ++i)
+            {
+                numPeriods += output[size_t(i - 1)] >= 0.f && output[size_t(i)] < 0.f;
+            }
+            // 220Hz over 2048 samples at 48kHz, with some pitch noise
+            expectGreaterOrEqual(numPeriods, 8);
+            expectLessOrEqual(numPeriods, 11);
+
+            // The main voice stays on the note with an odd number of voices,
+            // and is the one just above it with an even number
+            stack.setVoices(3, 20.f, 0.f);
+            expectEquals(stack.getMainPitchRatio(), 1.f);
+            stack.setVoices(2, 20.f, 0.f);
+            expectWithinAbsoluteError(stack.getMainPitchRatio(), std::exp2(20.f / 1200.f), 1e-6f);
+            stack.setVoices(8, 21.f, 0.f);
+            expectWithinAbsoluteError(stack.getMainPitchRatio(), std::exp2(3.f / 1200.f), 1e-6f);
+
+            // Every voice keeps the loudness of a single one
+            stack.setVoices(engine::UnisonStack::MAX_UNISON_VOICES, 50.f, 0.f);
+            std::fill(output.begin(), output.end(), 0.f);
+            stack.process(m_wavetables, positions.data(), 1.f, output.data(), BLOCK_SIZE);
+            expectWithinAbsoluteError(stack.getVoiceGain(),
+                    1.f / std::sqrt(float(engine::UnisonStack::MAX_UNISON_VOICES)), 1e-6f);
+
+            for (auto& sample : output)
             {
-                osc.prepare(samplerate, blockSize);
-                osc.process(buffer, 0, blockSize);
-                osc.process(buffer, 0, blockSize);
-                osc.process(buffer, 0, blockSize);
-                osc.reset();
+                expect(std::isfinite(sample));
+                expect(std::abs(sample) <= float(engine::UnisonStack::MAX_UNISON_VOICES));
             }
         }
     });
@@ -88,6 +206,8 @@ private:
     std::shared_ptr<control::ParameterMap>          m_parameterMap;
     engine::NoiseGenerator                          m_noiseGen;
     engine::SignalBus                               m_signalBus;
+    control::ParameterSnapshot                      m_parameters;
+    engine::WavetableBank                           m_wavetables;
     engine::Bindings                                m_bindings;
     juce::Random                                    m_rng;
 };
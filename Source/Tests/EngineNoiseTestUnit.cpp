@@ -59,9 +59,9 @@ public:
                 auto factor = noiseGen.getNoiseFactor();
 
                 expectGreaterThan(factor, 0.f, "negative noise factor");
-                expectGreaterThan(factor, 1.f - range, "noise factor out of bound");
+                expectGreaterOrEqual(factor, 1.f - range, "noise factor out of bound");
                 expectLessThan(factor, 2.f, "noise factor greater than 2");
-                expectLessThan(factor, 1.f + range, "noise factor out of range");
+                expectLessOrEqual(factor, 1.f + range, "noise factor out of range");
                 testCount++;
             }
         }
@@ -69,6 +69,94 @@ public:
         // Because we use loops we wanna make sure we tested enough times
         expectGreaterThan(testCount, 10);
     });
+
+    TEST("Block fill", [=] {
+        auto range = 0.03f;
+        auto noiseGen = engine::NoiseGenerator(range);
+        // Not a multiple of the number of lanes, to test the remaining samples
+        auto factors = std::vector<float>(4099);
+        auto sum = 0.;
+
+        noiseGen.fillNoiseFactors(factors.data(), int(factors.size()));
+
+        for (auto factor : factors)
+        {
+            expectGreaterOrEqual(factor, 1.f - range, "noise factor out of bound");
+            expectLessOrEqual(factor, 1.f + range, "noise factor out of range");
+            sum += factor;
+        }
+
+        expectWithinAbsoluteError(sum / factors.size(), 1., 0.002, "noise is not centered");
+    });
+
+    TEST("Seeding", [=] {
+        auto first = engine::NoiseGenerator(0.03f, 1234);
+        auto second = engine::NoiseGenerator(0.03f, 1234);
+        auto firstBlock = std::vector<float>(67);
+        auto secondBlock = std::vector<float>(67);
+
+        for (auto i = 0; i < 100; ++i)
+        {
+            expectEquals(first.getNoiseFactor(), second.getNoiseFactor());
+        }
+
+        first.fillNoiseFactors(firstBlock.data(), int(firstBlock.size()));
+        second.fillNoiseFactors(secondBlock.data(), int(secondBlock.size()));
+        expect(firstBlock == secondBlock, "The same seed gave two different blocks");
+
+        // A random seed can be replayed
+        auto random = engine::NoiseGenerator(0.03f);
+        auto replay = engine::NoiseGenerator(0.03f, random.getSeed());
+        expectEquals(random.getNoiseFactor(), replay.getNoiseFactor());
+    });
+
+    TEST("Fork", [=] {
+        auto parent = engine::NoiseGenerator(0.03f, 1234);
+        auto fork = parent.fork(engine::NoiseGenerator::FILTER);
+        auto otherFork = parent.fork(engine::NoiseGenerator::VOICE_POOL);
+
+        // The noise drawn by the parent has no effect on its forks
+        for (auto i = 0; i < 100; ++i)
+        {
+            parent.getNoiseFactor();
+        }
+
+        auto laterFork = parent.fork(engine::NoiseGenerator::FILTER);
+        auto sameStream = true;
+        auto otherStream = true;
+
+        for (auto i = 0; i < 100; ++i)
+        {
+            auto factor = fork.getNoiseFactor();
+            sameStream = sameStream && factor == laterFork.getNoiseFactor();
+            otherStream = otherStream && factor == otherFork.getNoiseFactor();
+        }
+
+        expect(sameStream, "The same stream id gave two different streams");
+        expect(! otherStream, "Two stream ids gave the same stream");
+    });
+
+    TEST("Drift", [=] {
+        auto range = 0.03f;
+        auto noiseGen = engine::NoiseGenerator(range);
+        auto drift = engine::NoiseDrift();
+        auto previous = 1.f;
+        auto maxStep = 0.f;
+
+        drift.prepare(750., 2.);
+
+        for (auto i = 0; i < 10000; ++i)
+        {
+            auto factor = drift.getNextDriftFactor(noiseGen);
+            expectGreaterThan(factor, 1.f - range, "drift factor out of bound");
+            expectLessThan(factor, 1.f + range, "drift factor out of range");
+            maxStep = juce::jmax(maxStep, std::abs(factor - previous));
+            previous = factor;
+        }
+
+        // The drift moves far slower than the noise
+        expectLessThan(maxStep, 0.1f * range, "drift is not smoothed");
+    });
     }
 
 private:
@@ -81,6 +81,35 @@ public:
         expect(testCount > 0);
     });
 
+    TEST("Modulation buffers", [=]{
+        auto signalBus = engine::SignalBus();
+        signalBus.prepare(256);
+        expectEquals(signalBus.getModulationBufferSize(), 256);
+
+        for (auto id = 0; id < engine::SignalBus::MAX; ++id)
+        {
+            auto iterId = engine::SignalBus::SignalId(id);
+            auto* writePtr = signalBus.getModulationWritePointer(iterId);
+            auto* readPtr = signalBus.getModulationReadPointer(iterId);
+            expect(writePtr == readPtr);
+
+            // Buffers are cleared by prepare
+            for (auto i = 0; i < 256; ++i)
+            {
+                expect(readPtr[i] == 0.f);
+                writePtr[i] = float(id * 256 + i);
+            }
+        }
+
+        // Each signal has its own buffer
+        for (auto id = 0; id < engine::SignalBus::MAX; ++id)
+        {
+            auto* readPtr = signalBus.getModulationReadPointer(engine::SignalBus::SignalId(id));
+            expect(readPtr[0] == float(id * 256));
+            expect(readPtr[255] == float(id * 256 + 255));
+        }
+    });
+
     }
 
 private:
@@ -14,6 +14,7 @@
 
 #include "Engine/Binding.h"
 #include "Engine/Filter/Filter.h"
+#include "Engine/Oscillators/WavetableBank.h"
 #include "Utils/Identifiers.h"
 
 namespace tests
@@ -27,7 +28,9 @@ public:
             category::engine::oscillators),
             m_noiseGen(0.05),
             m_signalBus(),
-            m_bindings{m_parameterMap, m_noiseGen, m_signalBus} {};
+            m_parameters(),
+            m_wavetables(),
+            m_bindings{m_parameterMap, m_noiseGen, m_signalBus, m_parameters, m_wavetables} {};
 
     void initialise() override
     {
@@ -41,6 +44,7 @@ public:
                 control::ControllableParameter(0.5, 0.0, 1.0);
         (*m_parameterMap)[identifiers::controls::FILTER_MIX] = 
                 control::ControllableParameter(0.5, 0.0, 1.0);
+        m_parameters = control::ParameterSnapshot::fromParameterMap(*m_parameterMap);
     }
 
     void shutdown() override
@@ -77,6 +81,7 @@ public:
                 auto block = juce::dsp::AudioBlock<float>(buffer);
                 auto processingContext = juce::dsp::ProcessContextReplacing<float>(block);
 
+                m_signalBus.prepare(blockSize);
                 filter.prepare(samplerate, blockSize);
                 filter.process(processingContext);
                 filter.process(processingContext);
@@ -86,6 +91,128 @@ public:
         }
     });
 
+    TEST("Oversampling", [=] {
+        auto blockSize = 64;
+        auto buffer = juce::AudioBuffer<float>(1, blockSize);
+        auto block = juce::dsp::AudioBlock<float>(buffer);
+        auto processingContext = juce::dsp::ProcessContextReplacing<float>(block);
+        auto* data = buffer.getWritePointer(0);
+        m_signalBus.prepare(blockSize);
+
+        for (auto factor : {1, 2, 4})
+        {
+            auto filter = engine::Filter(m_bindings, factor);
+            filter.prepare(48000.f, blockSize);
+            expectEquals(filter.getOversamplingFactor(), factor);
+            expect((filter.getLatencyInSamples() > 0.f) == (factor > 1));
+
+            // A low tone goes through the filters whatever the oversampling
+            auto magnitude = 0.f;
+
+            for (auto startSample = 0; startSample < 4800; startSample += blockSize)
+            {
+                for (auto i = 0; i < blockSize; ++i)
+                {
+                    data[i] = 0.5f * std::sin(juce::MathConstants<float>::twoPi
+                            * 100.f * (startSample + i) / 48000.f);
+                }
+
+                filter.process(processingContext);
+                magnitude = juce::jmax(magnitude, buffer.getMagnitude(0, 0, blockSize));
+
+                for (auto i = 0; i < blockSize; ++i)
+                {
+                    expect(std::isfinite(data[i]), "Non finite sample");
+                }
+            }
+
+            expectGreaterThan(magnitude, 0.01f);
+        }
+    });
+
+    TEST("Open303 block processing matches per sample processing", [=] {
+        auto input = juce::AudioBuffer<float>(1, 4096);
+
+        for (auto i = 0; i < input.getNumSamples(); ++i)
+        {
+            input.setSample(0, i, m_rng.nextFloat() - 0.5f);
+        }
+
+        // The block path has one loop for the TB_303 mode and one for the others
+        for (auto mode = 0; mode < rosic::TeeBeeFilter::NUM_MODES; ++mode)
+        {
+            for (auto sampleRate : {48000., 192000.})
+            {
+                auto sampleFilter = rosic::TeeBeeFilter();
+                auto blockFilter = rosic::TeeBeeFilter();
+
+                for (auto* filter : {&sampleFilter, &blockFilter})
+                {
+                    filter->setMode(mode);
+                    filter->setFeedbackHighpassCutoff(180);
+                    filter->setSampleRate(sampleRate);
+                    filter->setCutoff(800);
+                    filter->setResonance(90);
+                }
+
+                auto buffer = juce::AudioBuffer<float>(input);
+                auto expected = juce::AudioBuffer<float>(input);
+                auto* data = buffer.getWritePointer(0);
+                auto* expectedData = expected.getWritePointer(0);
+
+                for (auto i = 0; i < expected.getNumSamples(); ++i)
+                {
+                    expectedData[i] = float(sampleFilter.getSample(expectedData[i]));
+                }
+
+                for (auto i = 0; i < buffer.getNumSamples(); i += 64)
+                {
+                    blockFilter.processBlock(data + i, 64);
+                }
+
+                auto maxError = 0.f;
+
+                for (auto i = 0; i < buffer.getNumSamples(); ++i)
+                {
+                    maxError = juce::jmax(maxError, std::abs(data[i] - expectedData[i]));
+                }
+
+                expectLessThan(maxError, 1e-6f, "Float block processing diverged in mode "
+                        + juce::String(mode));
+            }
+        }
+    });
+
+    TEST("Oberheim ladder", [=] {
+        auto ladder = engine::OberheimLadder<float>();
+        auto buffer = juce::AudioBuffer<float>(1, 4096);
+        auto* data = buffer.getWritePointer(0);
+
+        ladder.prepare(48000.f);
+        ladder.setCutoff(500.f);
+        ladder.setResonance(4.f);
+
+        // A tone far above the cutoff is strongly attenuated
+        for (auto i = 0; i < buffer.getNumSamples(); ++i)
+        {
+            data[i] = 0.5f * std::sin(juce::MathConstants<float>::twoPi * 8000.f * i / 48000.f);
+        }
+
+        ladder.process(data, buffer.getNumSamples());
+        expectLessThan(buffer.getMagnitude(0, 2048, 2048), 0.01f);
+
+        // The state is cleared by reset
+        ladder.reset();
+        buffer.clear();
+        ladder.process(data, buffer.getNumSamples());
+        expectEquals(buffer.getMagnitude(0, 0, buffer.getNumSamples()), 0.f);
+
+        // The saturation is bounded
+        expectWithinAbsoluteError(engine::OberheimLadder<float>::fastTanh(10.f), 1.f, 1e-6f);
+        expectWithinAbsoluteError(engine::OberheimLadder<float>::fastTanh(0.5f),
+                std::tanh(0.5f), 0.01f);
+    });
+
 
     }
 
@@ -93,6 +220,8 @@ private:
     std::shared_ptr<control::ParameterMap>          m_parameterMap;
     engine::NoiseGenerator                          m_noiseGen;
     engine::SignalBus                               m_signalBus;
+    control::ParameterSnapshot                      m_parameters;
+    engine::WavetableBank                           m_wavetables;
     engine::Bindings                                m_bindings;
     juce::Random                                    m_rng;
 };
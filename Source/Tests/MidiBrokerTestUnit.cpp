@@ -80,8 +80,9 @@ public:
 
     TEST("Note MIDI buffer - Single Thread", [=] {
         auto broker = control::MidiBroker();
+        auto buffer = juce::MidiBuffer();
 
-        auto buffer = broker.getNoteMidiBuffer();
+        broker.popNoteMidiBuffer(buffer, 0., 48000., 512);
         expect(buffer.isEmpty());
 
         // Generate random midi messages for the broker
@@ -97,7 +98,7 @@ public:
         }
 
         // Get the buffer after the broker treated it
-        buffer = broker.getNoteMidiBuffer();
+        broker.popNoteMidiBuffer(buffer, 0., 48000., 512);
         expect(! buffer.isEmpty());
         auto bufferIt = buffer.begin();
         auto refIt = bufferRef.begin();
@@ -130,7 +131,8 @@ public:
             broker.handleIncomingMidiMessage(nullptr, msg);
         };
 
-        auto buffer = broker.getNoteMidiBuffer();
+        auto buffer = juce::MidiBuffer();
+        broker.popNoteMidiBuffer(buffer, 0., 48000., 512);
         expect(buffer.isEmpty());
 
         auto call_uid = callDispatcher.registerRecurrentCall(postMsgCall, postIntervalMs);
@@ -138,7 +140,7 @@ public:
         auto count = 0;
         for (auto i=0; i<30; ++i) {
             juce::Thread::sleep(postIntervalMs*20);
-            buffer = broker.getNoteMidiBuffer();
+            broker.popNoteMidiBuffer(buffer, 0., 48000., 512);
 
             for (auto msgIt : buffer) {
                 ++count;
@@ -155,7 +157,231 @@ public:
         expect(count > 30);
 
     });
-    
+
+    TEST("Note MIDI buffer - Sample positions", [=] {
+        auto broker = control::MidiBroker();
+        auto buffer = juce::MidiBuffer();
+        auto channel = broker.getMidiChannel();
+        // A power of two sample rate keeps the positions exact
+        double timestamps[] = {9.5, 10.0, 10.046875, 10.234375, 11.0};
+        int positions[] = {0, 0, 48, 240, 511};
+
+        for (auto i = 0; i < 5; ++i)
+        {
+            auto msg = juce::MidiMessage::noteOn(channel, 60 + i, 0.5f);
+            msg.setTimeStamp(timestamps[i]);
+            broker.handleIncomingMidiMessage(nullptr, msg);
+        }
+
+        // Late notes go to the start of the block, early ones to its end
+        broker.popNoteMidiBuffer(buffer, 10., 1024., 512);
+        expectEquals(buffer.getNumEvents(), 5);
+
+        auto i = 0;
+        for (auto metadata : buffer)
+        {
+            expectEquals(metadata.samplePosition, positions[i]);
+            expectEquals(metadata.getMessage().getNoteNumber(), 60 + i);
+            ++i;
+        }
+    });
+
+    TEST("Note MIDI buffer - Full fifo", [=] {
+        auto broker = control::MidiBroker();
+        auto buffer = juce::MidiBuffer();
+        auto channel = broker.getMidiChannel();
+
+        // The fifo keeps the oldest notes when it is full
+        for (auto i = 0; i < control::MidiBroker::NOTE_FIFO_SIZE + 10; ++i)
+        {
+            auto note = i % 128;
+            broker.handleIncomingMidiMessage(nullptr, juce::MidiMessage::noteOn(channel, note, 0.5f));
+        }
+
+        broker.popNoteMidiBuffer(buffer, 0., 48000., 512);
+        expectEquals(buffer.getNumEvents(), control::MidiBroker::NOTE_FIFO_SIZE - 1);
+        expectEquals((*buffer.begin()).getMessage().getNoteNumber(), 0);
+
+        // Once drained, the fifo accepts notes again
+        broker.handleIncomingMidiMessage(nullptr, juce::MidiMessage::noteOff(channel, 42));
+        broker.popNoteMidiBuffer(buffer, 0., 48000., 512);
+        expectEquals(buffer.getNumEvents(), 1);
+        expect((*buffer.begin()).getMessage().isNoteOff());
+    });
+
+    TEST("Parameter snapshot", [=] {
+        auto broker = control::MidiBroker();
+        auto parameterMap = broker.getIdToParameterMap().lock();
+        auto snapshot = broker.readParameterSnapshot();
+
+        // The first snapshot is published by the constructor
+        for (auto i = 0; i < control::ParameterSnapshot::NUM_PARAMETERS; ++i)
+        {
+            auto index = control::ParameterSnapshot::Index(i);
+            auto& parameter = (*parameterMap)[control::ParameterSnapshot::getIdentifier(index)];
+
+            expectEquals(snapshot.getValue(index), parameter.getCurrentValue());
+            expectEquals(snapshot.getRatio(index), parameter.getUnscaledRatioForCurrentValue());
+        }
+
+        // A controller change publishes a new one
+        auto settings = parameters::Parameter::loadParameters().m_parameters;
+        auto cutoffCC = settings.at(identifiers::controls::CUTOFF).m_cc;
+        auto& cutoff = (*parameterMap)[identifiers::controls::CUTOFF];
+        cutoff.setDiscretValue(0);
+
+        broker.handleIncomingMidiMessage(nullptr,
+                juce::MidiMessage::controllerEvent(broker.getMidiChannel(), cutoffCC, 70));
+        auto newSnapshot = broker.readParameterSnapshot();
+
+        expectGreaterThan(newSnapshot.m_version, snapshot.m_version);
+        expectEquals(newSnapshot.getValue(control::ParameterSnapshot::CUTOFF),
+                cutoff.getCurrentValue());
+        expectGreaterThan(newSnapshot.getRatio(control::ParameterSnapshot::CUTOFF), 0.f);
+
+        // Only the latest snapshot is read
+        for (auto i = 0; i < 5; ++i)
+        {
+            broker.handleIncomingMidiMessage(nullptr,
+                    juce::MidiMessage::controllerEvent(broker.getMidiChannel(), cutoffCC, 65));
+        }
+
+        expectEquals(broker.readParameterSnapshot().m_version, newSnapshot.m_version + 5);
+        expectEquals(broker.readParameterSnapshot().getValue(control::ParameterSnapshot::CUTOFF),
+                cutoff.getCurrentValue());
+    });
+
+    TEST("Unison voices", [=] {
+        auto broker = control::MidiBroker();
+        auto parameterMap = broker.getIdToParameterMap().lock();
+        auto& voices = (*parameterMap)[identifiers::controls::UNISON_VOICES];
+
+        // Each discret value is one more voice, from a single one to all 8
+        expectEquals(voices.getDiscretRange(), 8);
+
+        for (auto i = 0; i < voices.getDiscretRange(); ++i)
+        {
+            voices.setDiscretValue(i);
+            expectEquals(juce::roundToInt(voices.getCurrentValue()), i + 1);
+        }
+    });
+
+    TEST("Controller dispatch", [=] {
+        auto broker = control::MidiBroker();
+        auto parameterMap = broker.getIdToParameterMap().lock();
+        auto settings = parameters::Parameter::loadParameters().m_parameters;
+
+        // Every parameter is reached through its controller
+        for (auto i = 0; i < control::ParameterSnapshot::NUM_PARAMETERS; ++i)
+        {
+            auto index = control::ParameterSnapshot::Index(i);
+            const auto& identifier = control::ParameterSnapshot::getIdentifier(index);
+            auto& parameter = (*parameterMap)[identifier];
+            parameter.setDiscretValue(1);
+
+            broker.handleIncomingMidiMessage(nullptr, juce::MidiMessage::controllerEvent(
+                    broker.getMidiChannel(), settings.at(identifier).m_cc, 65));
+
+            expectEquals(parameter.getCurrentDiscretValue(), 2, identifier.toString());
+            expectEquals(broker.readParameterSnapshot().getValue(index),
+                    parameter.getCurrentValue(), identifier.toString());
+        }
+
+        // An unassigned controller does not publish anything
+        auto version = broker.readParameterSnapshot().m_version;
+        broker.handleIncomingMidiMessage(nullptr, 
+                juce::MidiMessage::controllerEvent(broker.getMidiChannel(), 127, 65));
+        expectEquals(broker.readParameterSnapshot().m_version, version);
+    });
+
+    TEST("Absolute and 14-bit controllers", [=] {
+        auto broker = control::MidiBroker();
+        auto parameterMap = broker.getIdToParameterMap().lock();
+        auto channel = broker.getMidiChannel();
+        auto settings = parameters::Parameter::loadParameters().m_parameters;
+        auto cutoffCC = settings.at(identifiers::controls::CUTOFF).m_cc;
+        auto attackCC = settings.at(identifiers::controls::ATTACK).m_cc;
+        auto& cutoff = (*parameterMap)[identifiers::controls::CUTOFF];
+        auto& attack = (*parameterMap)[identifiers::controls::ATTACK];
+        expectLessThan(cutoffCC, 32);
+        expectGreaterOrEqual(attackCC, 32);
+
+        broker.setAbsoluteControls(true);
+        expect(broker.hasAbsoluteControls());
+
+        // A 7-bit controller reaches both ends of the range
+        broker.handleIncomingMidiMessage(nullptr, 
+                juce::MidiMessage::controllerEvent(channel, attackCC, 127));
+        expectEquals(attack.getUnscaledRatioForCurrentValue(), 1.f);
+        broker.handleIncomingMidiMessage(nullptr, 
+                juce::MidiMessage::controllerEvent(channel, attackCC, 0));
+        expectEquals(attack.getUnscaledRatioForCurrentValue(), 0.f);
+
+        // The MSB alone is enough
+        broker.handleIncomingMidiMessage(nullptr, 
+                juce::MidiMessage::controllerEvent(channel, cutoffCC, 127));
+        expectEquals(cutoff.getUnscaledRatioForCurrentValue(), 1.f);
+
+        // The LSB sets the value btw the discret ones
+        broker.handleIncomingMidiMessage(nullptr, 
+                juce::MidiMessage::controllerEvent(channel, cutoffCC, 64));
+        broker.handleIncomingMidiMessage(nullptr, 
+                juce::MidiMessage::controllerEvent(channel, cutoffCC + 32, 37));
+        auto ratio = float((64 << 7) | 37) / 16383.f;
+        expectWithinAbsoluteError(cutoff.getUnscaledRatioForCurrentValue(), ratio, 1e-6f);
+        expectWithinAbsoluteError(broker.readParameterSnapshot()
+                .getRatio(control::ParameterSnapshot::CUTOFF), ratio, 1e-6f);
+
+        // Back to relative values, from the nearest discret value
+        broker.setAbsoluteControls(false);
+        broker.handleIncomingMidiMessage(nullptr, 
+                juce::MidiMessage::controllerEvent(channel, attackCC, 65));
+        expectEquals(attack.getCurrentDiscretValue(), 1);
+    });
+
+    TEST("NRPN", [=] {
+        auto broker = control::MidiBroker();
+        auto parameterMap = broker.getIdToParameterMap().lock();
+        auto channel = broker.getMidiChannel();
+        auto settings = parameters::Parameter::loadParameters().m_parameters;
+        auto resonanceCC = settings.at(identifiers::controls::RESONANCE).m_cc;
+        auto& resonance = (*parameterMap)[identifiers::controls::RESONANCE];
+        auto sendController = [&] (int number, int value)
+        {
+            broker.handleIncomingMidiMessage(nullptr,
+                    juce::MidiMessage::controllerEvent(channel, number, value));
+        };
+
+        // Without a selected NRPN the data entry is ignored
+        auto version = broker.readParameterSnapshot().m_version;
+        sendController(6, 100);
+        expectEquals(broker.readParameterSnapshot().m_version, version);
+
+        // Select the resonance and send a 14-bit value
+        sendController(99, 0);
+        sendController(98, resonanceCC);
+        sendController(6, 100);
+        sendController(38, 5);
+        auto ratio = float((100 << 7) | 5) / 16383.f;
+        expectWithinAbsoluteError(resonance.getUnscaledRatioForCurrentValue(), ratio, 1e-6f);
+        expectEquals(broker.readParameterSnapshot().m_version, version + 2);
+
+        // Increment and decrement move by one discret value
+        sendController(96, 0);
+        expectEquals(resonance.getCurrentDiscretValue(), 
+                juce::roundToInt(ratio * (resonance.getDiscretRange() - 1)) + 1);
+        sendController(97, 0);
+        sendController(97, 0);
+        expectEquals(resonance.getCurrentDiscretValue(), 
+                juce::roundToInt(ratio * (resonance.getDiscretRange() - 1)) - 1);
+
+        // A RPN deselects the NRPN
+        sendController(101, 0);
+        version = broker.readParameterSnapshot().m_version;
+        sendController(6, 0);
+        expectEquals(broker.readParameterSnapshot().m_version, version);
+    });
+
     }
 
 private:
@@ -0,0 +1,148 @@
+/*
+  ==============================================================================
+
+    OfflineRendererTestUnit.cpp
+    Created: 17 Oct 2026 11:02:45am
+    Author:  maxime
+
+  ==============================================================================
+*/
+
+#include "Tests/CustomTestUnit.h"
+#include "Tests/Utils.h"
+
+#include "Engine/Engine.h"
+#include "Engine/OfflineRenderer.h"
+#include "Control/MidiBroker.h"
+
+#include "Utils/Identifiers.h"
+#include "Utils/Parameters.h"
+
+namespace tests
+{
+
+class OfflineRendererTestUnit : public CustomTestUnit
+{
+public:
+    OfflineRendererTestUnit() : CustomTestUnit("Offline renderer testing",
+            category::engine::synth) {};
+
+    void runTest() override
+    {
+    TEST("Render a short sequence", [=] {
+        auto broker = control::MidiBroker();
+        auto engine = engine::RaciderryEngine(broker);
+        auto renderer = engine::OfflineRenderer(engine, broker);
+        auto sequence = juce::MidiMessageSequence();
+        auto output = juce::AudioBuffer<float>();
+
+        auto noteOn = juce::MidiMessage::noteOn(1, 48, 0.8f);
+        auto noteOff = juce::MidiMessage::noteOff(1, 48);
+        noteOn.setTimeStamp(0.01);
+        noteOff.setTimeStamp(0.2);
+        sequence.addEvent(noteOn);
+        sequence.addEvent(noteOff);
+
+        auto report = renderer.render(sequence, output, 48000., 64);
+
+        expect(output.getNumChannels() == 2);
+        expect(output.getNumSamples() > int(0.2 * 48000.));
+        expect(report.m_numBlocks > 0);
+        expect(report.m_renderedSeconds > 0.2);
+        expect(report.getRealTimeFactor() > 0.);
+        expectGreaterThan(output.getRMSLevel(0, 0, output.getNumSamples()), 0.f,
+                "The engine produced silence");
+
+        // The note starts at its exact sample, not on a block boundary
+        auto noteStart = int(0.01 * 48000.);
+        expectLessThan(output.getMagnitude(0, 0, noteStart - 1), 1e-6f,
+                "The note started too early");
+        expectGreaterThan(output.getMagnitude(0, noteStart, 64), 0.f,
+                "The note started too late");
+
+        // Every callback should have been profiled
+        auto profile = engine.getProfiler().computeReport();
+        auto& callbackStats = profile.m_stages[engine::DspProfiler::MAX];
+        expectEquals(profile.m_numCallbacks, report.m_numBlocks);
+        expectWithinAbsoluteError(profile.m_budget, 64. / 48000. * 1e6, 1e-6);
+        expect(callbackStats.m_min <= callbackStats.m_mean);
+        expect(callbackStats.m_mean <= callbackStats.m_max);
+        expect(callbackStats.m_p99 <= callbackStats.m_max);
+    });
+
+    TEST("Reproducible render", [=] {
+        auto sequence = juce::MidiMessageSequence();
+        auto noteOn = juce::MidiMessage::noteOn(1, 48, 0.8f);
+        auto noteOff = juce::MidiMessage::noteOff(1, 48);
+        noteOn.setTimeStamp(0.01);
+        noteOff.setTimeStamp(0.2);
+        sequence.addEvent(noteOn);
+        sequence.addEvent(noteOff);
+
+        auto renderWithSeed = [&sequence](juce::uint64 seed) {
+            auto broker = control::MidiBroker();
+            auto engine = engine::RaciderryEngine(broker, seed);
+            auto renderer = engine::OfflineRenderer(engine, broker);
+            auto output = juce::AudioBuffer<float>();
+            renderer.render(sequence, output, 48000., 64);
+            return output;
+        };
+
+        auto first = renderWithSeed(42);
+        auto second = renderWithSeed(42);
+        auto other = renderWithSeed(43);
+
+        expectEquals(first.getNumSamples(), second.getNumSamples());
+        expect(std::equal(first.getReadPointer(0), first.getReadPointer(0) + first.getNumSamples(),
+                second.getReadPointer(0)), "The same seed gave two different renders");
+        expect(! std::equal(first.getReadPointer(0), first.getReadPointer(0) + first.getNumSamples(),
+                other.getReadPointer(0)), "Two seeds gave the same render");
+    });
+
+    TEST("Parameter changes", [=] {
+        auto settings = parameters::Parameter::loadParameters().m_parameters;
+        auto releaseCC = settings.at(identifiers::controls::RELEASE).m_cc;
+
+        auto renderWithRelease = [&](bool longRelease) {
+            auto sequence = juce::MidiMessageSequence();
+            auto noteOn = juce::MidiMessage::noteOn(1, 48, 0.8f);
+            auto noteOff = juce::MidiMessage::noteOff(1, 48);
+            noteOn.setTimeStamp(0.01);
+            noteOff.setTimeStamp(0.2);
+            sequence.addEvent(noteOn);
+            sequence.addEvent(noteOff);
+
+            // Move the release to its max while the note is playing
+            for (auto i = 0; longRelease && i < 16; ++i)
+            {
+                auto cc = juce::MidiMessage::controllerEvent(1, releaseCC, 74);
+                cc.setTimeStamp(0.1);
+                sequence.addEvent(cc);
+            }
+            sequence.sort();
+
+            auto broker = control::MidiBroker();
+            auto engine = engine::RaciderryEngine(broker, 42);
+            auto renderer = engine::OfflineRenderer(engine, broker);
+            auto output = juce::AudioBuffer<float>();
+            renderer.render(sequence, output, 48000., 64);
+            return output;
+        };
+
+        // No message thread is running, the envelope must pick up the new
+        // release from the audio thread
+        auto shortRelease = renderWithRelease(false);
+        auto longRelease = renderWithRelease(true);
+        auto tailStart = int(0.5 * 48000.);
+        auto tailLength = int(0.1 * 48000.);
+
+        expectGreaterThan(longRelease.getRMSLevel(0, tailStart, tailLength),
+                10.f * shortRelease.getRMSLevel(0, tailStart, tailLength),
+                "The release change was not applied");
+    });
+    }
+};
+
+static OfflineRendererTestUnit OFFLINE_RENDERER_TEST;
+
+} // namespace tests
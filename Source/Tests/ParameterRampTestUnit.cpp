@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+
+    ParameterRampTestUnit.cpp
+    Created: 17 Oct 2026 10:31:52pm
+    Author:  maxime
+
+  ==============================================================================
+*/
+
+#include "Tests/CustomTestUnit.h"
+#include "Tests/Utils.h"
+
+#include "Engine/ParameterRamp.h"
+#include "Utils/CustomSmoothValue.h"
+
+namespace tests
+{
+
+constexpr auto RAMP_SAMPLE_RATE = 48000.;
+
+class ParameterRampTestUnit : public CustomTestUnit
+{
+public:
+    ParameterRampTestUnit() : CustomTestUnit("Parameter ramp testing",
+            category::engine::bindings) {};
+
+    void runTest() override
+    {
+
+    TEST("Fill ramp", [=] {
+        auto linear = utils::CustomSmoothedValue<float>(0.f);
+        auto linearRef = utils::CustomSmoothedValue<float>(0.f);
+        auto multiplicative = utils::CustomSmoothedValue<float,
+                juce::ValueSmoothingTypes::Multiplicative>(100.f);
+        auto multiplicativeRef = utils::CustomSmoothedValue<float,
+                juce::ValueSmoothingTypes::Multiplicative>(100.f);
+        auto ramp = std::vector<float>(100);
+
+        for (auto* value : {&linear, &linearRef}) { value->reset(250); value->setTargetValue(1.f); }
+        for (auto* value : {&multiplicative, &multiplicativeRef}) { value->reset(250); value->setTargetValue(1000.f); }
+
+        // Uneven blocks, the last one goes past the end of the ramp
+        for (auto numSamples : {1, 64, 100, 100})
+        {
+            linear.fillRamp(ramp.data(), numSamples);
+            for (auto i = 0; i < numSamples; ++i)
+            {
+                expectWithinAbsoluteError(ramp[size_t(i)], linearRef.getNextValue(), 1e-5f);
+            }
+
+            multiplicative.fillRamp(ramp.data(), numSamples);
+            for (auto i = 0; i < numSamples; ++i)
+            {
+                expectWithinAbsoluteError(ramp[size_t(i)], multiplicativeRef.getNextValue(), 1e-2f);
+            }
+        }
+
+        expect(! linear.isSmoothing());
+        expect(! multiplicative.isSmoothing());
+        expectEquals(ramp.back(), 1000.f);
+    });
+
+    TEST("Block size", [=] {
+        auto parameters = control::ParameterSnapshot();
+        parameters.m_values.fill(0.f);
+        parameters.m_ratios.fill(0.f);
+
+        auto smallBlocks = engine::ParameterRamp(parameters, control::ParameterSnapshot::CUTOFF);
+        auto largeBlocks = engine::ParameterRamp(parameters, control::ParameterSnapshot::CUTOFF);
+        smallBlocks.prepare(RAMP_SAMPLE_RATE, 32);
+        largeBlocks.prepare(RAMP_SAMPLE_RATE, 1024);
+
+        parameters.m_values[control::ParameterSnapshot::CUTOFF] = 1000.f;
+        auto rampLength = int(engine::ParameterRamp::RAMP_LENGTH_S * RAMP_SAMPLE_RATE);
+        auto largeRamp = std::vector<float>(1024);
+
+        largeBlocks.updateTarget();
+        std::copy_n(largeBlocks.getNextRamp(1024), 1024, largeRamp.begin());
+
+        // The ramp lasts as long whatever the block size
+        for (auto start = 0; start < 1024; start += 32)
+        {
+            smallBlocks.updateTarget();
+            auto* ramp = smallBlocks.getNextRamp(32);
+
+            for (auto i = 0; i < 32; ++i)
+            {
+                expectWithinAbsoluteError(ramp[i], largeRamp[size_t(start + i)], 1e-2f);
+            }
+        }
+
+        expectLessThan(largeRamp[size_t(rampLength - 2)], 1000.f, "The ramp is too short");
+        expectEquals(largeRamp[size_t(rampLength - 1)], 1000.f, "The ramp is too long");
+        expect(! smallBlocks.isSmoothing());
+    });
+
+    }
+};
+
+static ParameterRampTestUnit                        PARAMETER_RAMP_UNIT;
+
+} // namespace tests
@@ -0,0 +1,203 @@
+/*
+  ==============================================================================
+
+    PresetBankTestUnit.cpp
+    Created: 18 Oct 2026 12:31:06am
+    Author:  maxime
+
+  ==============================================================================
+*/
+
+#include "Tests/CustomTestUnit.h"
+#include "Tests/Utils.h"
+
+#include "Control/PresetBank.h"
+#include "Control/PresetWriter.h"
+
+namespace tests
+{
+
+class PresetBankTestUnit : public CustomTestUnit
+{
+public:
+    PresetBankTestUnit() : CustomTestUnit("Preset bank testing", category::control) {};
+
+    void initialise() override
+    {
+        m_rng = getRandom();
+    }
+
+    void shutdown() override
+    {
+    }
+
+    void singleTestInit() override
+    {
+        // Random parameters with different resolutions
+        for (auto i = 0; i < control::ParameterSnapshot::NUM_PARAMETERS; ++i)
+        {
+            m_parameters[size_t(i)] = control::ControllableParameter(0.f, 0.f, 1.f,
+                    control::ControllableParameter::ScaleType::linear, 128 << (i % 3));
+            m_parameters[size_t(i)].setDiscretValue(m_rng.nextInt(128));
+        }
+    }
+
+    void singleTestShutdown() override
+    {
+    }
+
+    void runTest() override
+    {
+    TEST("Store and apply", [=] {
+        auto bank = control::PresetBank();
+        auto reference = takeValues();
+
+        expect(! bank.hasPreset(5));
+        expect(! bank.applyPreset(5, m_parameters));
+
+        bank.storePreset(5, m_parameters);
+        expect(bank.hasPreset(5));
+
+        // Change every parameter, then restore the preset
+        for (auto& parameter : m_parameters)
+        {
+            parameter.setRatio(m_rng.nextFloat());
+        }
+
+        expect(bank.applyPreset(5, m_parameters));
+        expectValues(reference);
+
+        // Storing again replaces the slot
+        m_parameters[0].setDiscretValue(0);
+        bank.storePreset(5, m_parameters);
+        m_parameters[0].setDiscretValue(10);
+        bank.applyPreset(5, m_parameters);
+        expectEquals(m_parameters[0].getCurrentDiscretValue(), 0);
+    });
+
+    TEST("File round trip", [=] {
+        auto bank = control::PresetBank();
+        auto file = juce::File::createTempFile("bank");
+        auto reference = takeValues();
+
+        bank.storePreset(0, m_parameters);
+        bank.storePreset(127, m_parameters);
+        expect(bank.saveToFile(file));
+
+        auto loadedBank = control::PresetBank();
+        expect(loadedBank.loadFromFile(file));
+        expect(loadedBank.hasPreset(0));
+        expect(loadedBank.hasPreset(127));
+        expect(! loadedBank.hasPreset(64));
+
+        for (auto& parameter : m_parameters)
+        {
+            parameter.setDiscretValue(0);
+        }
+
+        loadedBank.applyPreset(127, m_parameters);
+        expectValues(reference);
+
+        // A corrupted file is rejected and leaves the bank unchanged
+        file.replaceWithText("not a preset bank");
+        expect(! loadedBank.loadFromFile(file));
+        expect(loadedBank.hasPreset(0));
+
+        file.deleteFile();
+    });
+
+    TEST("Legacy XML import", [=] {
+        auto bank = control::PresetBank();
+        auto file = juce::File::createTempFile("xml");
+        auto xml = juce::XmlElement("PRESETS");
+        auto& parameter = m_parameters[control::ParameterSnapshot::CUTOFF];
+        const auto& cutoffId = control::ParameterSnapshot::getIdentifier(
+                control::ParameterSnapshot::CUTOFF);
+
+        // The legacy saves appended a new preset each time, the last one wins
+        xml.createNewChildElement("preset_3")->setAttribute(cutoffId, 10);
+        xml.createNewChildElement("preset_3")->setAttribute(cutoffId, 42);
+        expect(xml.writeTo(file));
+
+        expect(bank.importLegacyXml(file, m_parameters));
+        expect(bank.hasPreset(3));
+        expect(! bank.hasPreset(2));
+
+        parameter.setDiscretValue(0);
+        bank.applyPreset(3, m_parameters);
+        expectEquals(parameter.getCurrentDiscretValue(), 42);
+
+        file.deleteFile();
+    });
+
+    TEST("Background writer", [=] {
+        auto bank = control::PresetBank();
+        auto file = juce::File::createTempFile("bank");
+        constexpr auto numRequests = 200;
+
+        {
+            auto writer = control::PresetWriter(file);
+
+            // Each request replaces a slot, the writer only keeps the latest
+            for (auto i = 0; i < numRequests; ++i)
+            {
+                m_parameters[0].setDiscretValue(i % 128);
+                bank.storePreset(i % 16, m_parameters);
+                writer.requestWrite(bank);
+            }
+
+            expect(writer.waitUntilWritten(5000));
+            expectGreaterThan(writer.getNumWrites(), 0);
+            expectLessOrEqual(writer.getNumWrites(), numRequests);
+
+            // The last request is written when the writer is destroyed
+            bank.storePreset(100, m_parameters);
+            writer.requestWrite(bank);
+        }
+
+        auto loadedBank = control::PresetBank();
+        expect(loadedBank.loadFromFile(file));
+
+        for (auto slot = 0; slot < 16; ++slot)
+        {
+            expect(loadedBank.hasPreset(slot));
+        }
+
+        expect(loadedBank.hasPreset(100));
+        loadedBank.applyPreset((numRequests - 1) % 16, m_parameters);
+        expectEquals(m_parameters[0].getCurrentDiscretValue(), (numRequests - 1) % 128);
+
+        file.deleteFile();
+    });
+
+    }
+
+private:
+    std::array<float, control::ParameterSnapshot::NUM_PARAMETERS> takeValues() const
+    {
+        auto values = std::array<float, control::ParameterSnapshot::NUM_PARAMETERS>();
+
+        for (auto i = 0; i < control::ParameterSnapshot::NUM_PARAMETERS; ++i)
+        {
+            values[size_t(i)] = m_parameters[size_t(i)].getCurrentValue();
+        }
+
+        return values;
+    }
+
+    void expectValues(const std::array<float, control::ParameterSnapshot::NUM_PARAMETERS>& values)
+    {
+        for (auto i = 0; i < control::ParameterSnapshot::NUM_PARAMETERS; ++i)
+        {
+            expectWithinAbsoluteError(m_parameters[size_t(i)].getCurrentValue(),
+                    values[size_t(i)], 1e-5f);
+        }
+    }
+
+    control::ParameterRegistry                        m_parameters;
+    juce::Random                                      m_rng;
+};
+
+static PresetBankTestUnit PRESET_BANK_TEST;
+
+} // namespace tests
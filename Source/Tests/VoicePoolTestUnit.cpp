@@ -0,0 +1,144 @@
+/*
+  ==============================================================================
+
+    VoicePoolTestUnit.cpp
+    Created: 17 Oct 2026 8:02:37pm
+    Author:  maxime
+
+  ==============================================================================
+*/
+
+#include "Tests/CustomTestUnit.h"
+#include "Tests/Utils.h"
+
+#include "Engine/Binding.h"
+#include "Engine/VoicePool.h"
+#include "Control/MidiBroker.h"
+
+namespace tests
+{
+
+constexpr auto POOL_SAMPLE_RATE = 48000.;
+constexpr auto POOL_BLOCK_SIZE = 512;
+constexpr auto POOL_NUM_VOICES = 4;
+
+class VoicePoolTestUnit : public CustomTestUnit
+{
+public:
+    VoicePoolTestUnit() : CustomTestUnit("Voice pool testing",
+            category::engine::synth),
+            m_parameters(),
+            m_noiseGen(0.03),
+            m_signalBus(),
+            m_wavetables(),
+            m_buffer(1, POOL_BLOCK_SIZE) {};
+
+    void initialise() override
+    {
+        m_broker = std::make_unique<control::MidiBroker>();
+        m_parameters = m_broker->readParameterSnapshot();
+        m_signalBus.prepare(POOL_BLOCK_SIZE);
+    }
+
+    void shutdown() override
+    {
+        m_broker.reset();
+    }
+
+    void runTest() override
+    {
+
+    TEST("Chord", [=] {
+        auto pool = createPool();
+        auto midi = juce::MidiBuffer();
+
+        midi.addEvent(juce::MidiMessage::noteOn(1, 48, 0.8f), 0);
+        midi.addEvent(juce::MidiMessage::noteOn(1, 52, 0.8f), 0);
+        midi.addEvent(juce::MidiMessage::noteOn(1, 55, 0.8f), 0);
+        pool->renderNextBlock(m_buffer, midi, 0, POOL_BLOCK_SIZE);
+
+        expectEquals(pool->getNumActiveVoices(), 3);
+        expectGreaterThan(m_buffer.getRMSLevel(0, 0, POOL_BLOCK_SIZE), 0.f,
+                "The pool produced silence");
+
+        // Retriggering a playing note does not use another voice
+        midi.clear();
+        midi.addEvent(juce::MidiMessage::noteOn(1, 52, 0.8f), 0);
+        pool->renderNextBlock(m_buffer, midi, 0, POOL_BLOCK_SIZE);
+        expectEquals(pool->getNumActiveVoices(), 3);
+    });
+
+    TEST("Voice stealing", [=] {
+        auto pool = createPool();
+        auto midi = juce::MidiBuffer();
+
+        for (auto note = 48; note < 48 + 2 * POOL_NUM_VOICES; ++note)
+        {
+            midi.addEvent(juce::MidiMessage::noteOn(1, note, 0.8f), note);
+        }
+
+        pool->renderNextBlock(m_buffer, midi, 0, POOL_BLOCK_SIZE);
+        expectEquals(pool->getNumActiveVoices(), POOL_NUM_VOICES);
+    });
+
+    TEST("Release", [=] {
+        auto pool = createPool();
+        auto midi = juce::MidiBuffer();
+
+        midi.addEvent(juce::MidiMessage::noteOn(1, 48, 0.8f), 0);
+        midi.addEvent(juce::MidiMessage::noteOn(1, 60, 0.8f), 0);
+        pool->renderNextBlock(m_buffer, midi, 0, POOL_BLOCK_SIZE);
+
+        midi.clear();
+        midi.addEvent(juce::MidiMessage::noteOff(1, 48), 0);
+        midi.addEvent(juce::MidiMessage::noteOff(1, 60), 0);
+        pool->renderNextBlock(m_buffer, midi, 0, POOL_BLOCK_SIZE);
+        midi.clear();
+
+        // The release is 5s at most
+        for (auto i = 0; i < int(6. * POOL_SAMPLE_RATE) / POOL_BLOCK_SIZE; ++i)
+        {
+            pool->renderNextBlock(m_buffer, midi, 0, POOL_BLOCK_SIZE);
+        }
+
+        expectEquals(pool->getNumActiveVoices(), 0);
+        expectEquals(m_buffer.getMagnitude(0, 0, POOL_BLOCK_SIZE), 0.f);
+    });
+
+    TEST("Note position", [=] {
+        auto pool = createPool();
+        auto midi = juce::MidiBuffer();
+        auto notePosition = 100;
+
+        midi.addEvent(juce::MidiMessage::noteOn(1, 48, 0.8f), notePosition);
+        pool->renderNextBlock(m_buffer, midi, 0, POOL_BLOCK_SIZE);
+
+        expectEquals(m_buffer.getMagnitude(0, 0, notePosition), 0.f,
+                "The note started too early");
+        expectGreaterThan(m_buffer.getMagnitude(0, notePosition, POOL_BLOCK_SIZE - notePosition),
+                0.f, "The note did not start");
+    });
+
+    }
+
+private:
+    std::unique_ptr<engine::VoicePool> createPool()
+    {
+        auto pool = std::make_unique<engine::VoicePool>(POOL_NUM_VOICES,
+                engine::Bindings({m_broker->getIdToParameterMap(), m_noiseGen, m_signalBus,
+                    m_parameters, m_wavetables}));
+        pool->prepare(POOL_SAMPLE_RATE, POOL_BLOCK_SIZE);
+        return pool;
+    }
+
+    std::unique_ptr<control::MidiBroker>            m_broker;
+    control::ParameterSnapshot                      m_parameters;
+    engine::NoiseGenerator                          m_noiseGen;
+    engine::SignalBus                               m_signalBus;
+    engine::WavetableBank                           m_wavetables;
+    juce::AudioBuffer<float>                        m_buffer;
+};
+
+static VoicePoolTestUnit                            VOICEPOOL_UNIT;
+
+} // namespace tests
@@ -15,6 +15,7 @@
 
 #include "Engine/Binding.h"
 #include "Engine/Oscillators/WavetableOscillator.h"
+#include "Utils/Utils.h"
 
 namespace tests
 {
@@ -29,7 +30,9 @@ public:
             m_waveform(1, 2048),
             m_noiseGen(0.05),
             m_signalBus(),
-            m_bindings{m_parameterMap, m_noiseGen, m_signalBus} {};
+            m_parameters(),
+            m_wavetables(),
+            m_bindings{m_parameterMap, m_noiseGen, m_signalBus, m_parameters, m_wavetables} {};
 
     void initialise() override
     {
@@ -83,6 +86,257 @@ public:
         }
     });
 
+    TEST("Mipmap levels", [=] {
+        auto wavetable = juce::AudioSampleBuffer(1, 2048);
+        auto tableSize = wavetable.getNumSamples();
+        auto* data = wavetable.getWritePointer(0);
+
+        for (auto i = 0; i < tableSize; ++i)
+        {
+            data[i] = utils::waveform::saw(juce::MathConstants<float>::twoPi * i / tableSize);
+        }
+
+        utils::waveform::buildMipmaps(wavetable);
+        expectEquals(wavetable.getNumChannels(), 10);
+
+        // Each level keeps half the harmonics of the previous one, so it
+        // holds less energy
+        for (auto level = 1; level < wavetable.getNumChannels(); ++level)
+        {
+            expectLessThan(wavetable.getRMSLevel(level, 0, tableSize),
+                    wavetable.getRMSLevel(level - 1, 0, tableSize));
+        }
+
+        // The last level only keeps the fundamental of the saw
+        auto* sine = wavetable.getReadPointer(wavetable.getNumChannels() - 1);
+        auto maxError = 0.f;
+
+        for (auto i = 0; i < tableSize; ++i)
+        {
+            auto expected = 2.f / juce::MathConstants<float>::pi
+                    * std::sin(juce::MathConstants<float>::twoPi * i / tableSize);
+            maxError = juce::jmax(maxError, std::abs(sine[i] - expected));
+        }
+
+        expectLessThan(maxError, 5e-3f, "The last level should be a sine");
+    });
+
+    TEST("Mipmapped wavetable processing", [=] {
+        auto wavetable = juce::AudioSampleBuffer(1, 2048);
+        auto* data = wavetable.getWritePointer(0);
+
+        for (auto i = 0; i < wavetable.getNumSamples(); ++i)
+        {
+            data[i] = utils::waveform::square(
+                    juce::MathConstants<float>::twoPi * i / wavetable.getNumSamples());
+        }
+
+        utils::waveform::buildMipmaps(wavetable);
+
+        auto osc = engine::WavetableOscillator(wavetable, m_bindings);
+        auto buffer = juce::AudioBuffer<float>(1, BLOCK_SIZE);
+        auto block = juce::dsp::AudioBlock<float>(buffer);
+        auto processingContext = juce::dsp::ProcessContextReplacing<float>(block);
+        float frequencies[] = {20.f, 110.f, 880.f, 4000.f, 15000.f};
+
+        osc.prepare(48000, BLOCK_SIZE);
+
+        for (auto frequency : frequencies)
+        {
+            // Going through all the levels, while gliding and while not
+            osc.setGlide(0.f);
+            osc.setFrequency(frequency);
+            osc.process(processingContext);
+            expectLessThan(buffer.getMagnitude(0, 0, BLOCK_SIZE), 1.5f);
+
+            osc.setGlide(0.01f);
+            osc.setFrequency(frequency * 0.5f);
+            osc.process(processingContext);
+            expectLessThan(buffer.getMagnitude(0, 0, BLOCK_SIZE), 1.5f);
+        }
+    });
+
+    TEST("Morph", [=] {
+        // The three oscillators share the same noise stream
+        auto osc = engine::WavetableOscillator(m_wavetables.getFrame(0), m_bindings);
+        auto scalarOsc = engine::WavetableOscillator(m_wavetables.getFrame(0), m_bindings);
+        auto simdOsc = engine::WavetableOscillator(m_wavetables.getFrame(0), m_bindings);
+        auto buffer = juce::AudioBuffer<float>(3, BLOCK_SIZE);
+        auto block = juce::dsp::AudioBlock<float>(buffer).getSingleChannelBlock(0);
+        auto processingContext = juce::dsp::ProcessContextReplacing<float>(block);
+        auto position = std::vector<float>(BLOCK_SIZE, 0.f);
+
+        for (auto* oscillator : {&osc, &scalarOsc, &simdOsc})
+        {
+            oscillator->prepare(48000, BLOCK_SIZE);
+            oscillator->setFrequency(220.f);
+        }
+
+        // At the first position, only the first frame is heard
+        osc.process(processingContext);
+        scalarOsc.processMorph(m_wavetables, position.data(), 1.f,
+                buffer.getWritePointer(1), BLOCK_SIZE, false);
+        simdOsc.processMorph(m_wavetables, position.data(), 1.f,
+                buffer.getWritePointer(2), BLOCK_SIZE, true);
+
+        for (auto i = 0; i < BLOCK_SIZE; ++i)
+        {
+            expectWithinAbsoluteError(buffer.getSample(1, i), buffer.getSample(0, i), 1e-6f);
+            expectWithinAbsoluteError(buffer.getSample(2, i), buffer.getSample(0, i), 1e-6f);
+        }
+
+        // The SIMD kernel matches the scalar one, whatever the block size and
+        // while gliding
+        for (auto& value : position) { value = m_rng.nextFloat(); }
+
+        for (auto numSamples : {BLOCK_SIZE, 1001, 3})
+        {
+            scalarOsc.setGlide(0.01f);
+            simdOsc.setGlide(0.01f);
+            scalarOsc.setFrequency(880.f);
+            simdOsc.setFrequency(880.f);
+            scalarOsc.processMorph(m_wavetables, position.data(), 0.5f,
+                    buffer.getWritePointer(1), numSamples, false);
+            simdOsc.processMorph(m_wavetables, position.data(), 0.5f,
+                    buffer.getWritePointer(2), numSamples, true);
+
+            for (auto i = 0; i < numSamples; ++i)
+            {
+                expectWithinAbsoluteError(buffer.getSample(2, i), buffer.getSample(1, i), 1e-5f);
+            }
+        }
+    });
+
+    TEST("Phase wrap", [=] {
+        // Without pitch noise, 256Hz at 32768Hz advances by exactly 16 samples
+        // of the table : the phase lands on the table size every 128 samples
+        auto noiseGen = engine::NoiseGenerator(0.f);
+        auto bindings = engine::Bindings{m_parameterMap, noiseGen, m_signalBus, m_parameters,
+                m_wavetables};
+        auto position = std::vector<float>(BLOCK_SIZE, 0.f);
+        constexpr auto period = 128;
+
+        for (auto useSIMD : {false, true})
+        {
+            auto osc = engine::WavetableOscillator(m_wavetables.getFrame(0), bindings);
+            auto output = std::vector<float>(BLOCK_SIZE);
+            osc.prepare(32768, BLOCK_SIZE);
+            osc.setFrequency(256.f, true);
+            osc.processMorph(m_wavetables, position.data(), 1.f, output.data(), BLOCK_SIZE,
+                    useSIMD);
+
+            // The phase wraps to the start of the table, never past its end
+            for (auto i = period; i < BLOCK_SIZE; ++i)
+            {
+                expectEquals(output[size_t(i)], output[size_t(i - period)]);
+            }
+        }
+    });
+
+    TEST("Wavetable bank", [=] {
+        // The default bank holds the saw and the square
+        expectEquals(m_wavetables.getNumFrames(), 2);
+        expectEquals(m_wavetables.getNumLevels(),
+                utils::waveform::getNumMipmapLevels(engine::WavetableBank::TABLE_SIZE));
+
+        // Frames of any size, resampled to the table size
+        auto bank = engine::WavetableBank();
+        auto frames = std::vector<juce::AudioSampleBuffer>();
+
+        for (auto size : {512, 2048, 4096})
+        {
+            auto frame = juce::AudioSampleBuffer(1, size);
+
+            for (auto i = 0; i < size; ++i)
+            {
+                frame.setSample(0, i, std::sin(juce::MathConstants<float>::twoPi * i / size));
+            }
+
+            frames.push_back(frame);
+        }
+
+        bank.setFrames(frames);
+        expectEquals(bank.getNumFrames(), 3);
+
+        for (auto frame = 0; frame < bank.getNumFrames(); ++frame)
+        {
+            auto* sine = bank.getLevel(frame, 0);
+            expectWithinAbsoluteError(sine[engine::WavetableBank::TABLE_SIZE / 4], 1.f, 1e-3f);
+
+            for (auto level = 0; level < bank.getNumLevels(); ++level)
+            {
+                auto address = reinterpret_cast<std::uintptr_t>(bank.getLevel(frame, level));
+                expectEquals(int(address % engine::WavetableBank::ALIGNMENT_BYTES), 0);
+            }
+        }
+
+        // The position goes through the adjacent frames
+        auto morph = bank.getMorph(0.25f);
+        expectEquals(morph.m_lowerFrame, 0);
+        expectEquals(morph.m_upperFrame, 1);
+        expectWithinAbsoluteError(morph.m_frac, 0.5f, 1e-6f);
+
+        morph = bank.getMorph(1.f);
+        expectEquals(morph.m_lowerFrame, 1);
+        expectEquals(morph.m_upperFrame, 2);
+        expectWithinAbsoluteError(morph.m_frac, 1.f, 1e-6f);
+
+        morph = bank.getMorph(-1.f);
+        expectEquals(morph.m_lowerFrame, 0);
+        expectEquals(morph.m_frac, 0.f);
+    });
+
+    TEST("Wavetable bank directory", [=] {
+        auto directory = juce::File::createTempFile("wavetables");
+        directory.createDirectory();
+
+        // Files sorted by name, the other files are ignored
+        auto names = {"b_negative.wav", "a_positive.wav"};
+        auto sign = -1.f;
+
+        for (auto name : names)
+        {
+            auto frame = juce::AudioSampleBuffer(1, 1024);
+
+            for (auto i = 0; i < frame.getNumSamples(); ++i)
+            {
+                frame.setSample(0, i, sign * std::sin(juce::MathConstants<float>::twoPi
+                        * i / frame.getNumSamples()));
+            }
+
+            auto stream = std::make_unique<juce::FileOutputStream>(directory.getChildFile(name));
+            auto wavFormat = juce::WavAudioFormat();
+            auto writer = std::unique_ptr<juce::AudioFormatWriter>(
+                    wavFormat.createWriterFor(stream.get(), 48000, 1, 32, {}, 0));
+            expect(writer != nullptr, "Could not write the wavetable");
+
+            if (writer == nullptr)
+            {
+                return;
+            }
+
+            stream.release();
+            writer->writeFromAudioSampleBuffer(frame, 0, frame.getNumSamples());
+            sign = 1.f;
+        }
+
+        directory.getChildFile("readme.txt").replaceWithText("not a wavetable");
+
+        auto bank = engine::WavetableBank();
+        expect(bank.loadFromDirectory(directory));
+        expectEquals(bank.getNumFrames(), 2);
+
+        auto quarter = engine::WavetableBank::TABLE_SIZE / 4;
+        expectWithinAbsoluteError(bank.getLevel(0, 0)[quarter], 1.f, 1e-3f);
+        expectWithinAbsoluteError(bank.getLevel(1, 0)[quarter], -1.f, 1e-3f);
+
+        // Without any wav file the bank is unchanged
+        directory.deleteRecursively();
+        directory.createDirectory();
+        expect(! bank.loadFromDirectory(directory));
+        expectEquals(bank.getNumFrames(), 2);
+        directory.deleteRecursively();
+    });
 
     }
 
@@ -91,6 +345,8 @@ private:
     std::shared_ptr<control::ParameterMap>          m_parameterMap;
     engine::NoiseGenerator                          m_noiseGen;
     engine::SignalBus                               m_signalBus;
+    control::ParameterSnapshot                      m_parameters;
+    engine::WavetableBank                           m_wavetables;
     engine::Bindings                                m_bindings;
     juce::Random                                    m_rng;
 };
@@ -187,6 +187,42 @@ public:
         skip(this->countdown);
     }
 
+    /**
+     * @brief Write the next numSamples values into the destination buffer
+     * 
+     * This gives the same values than calling getNextValue numSamples times,
+     * up to rounding errors. The linear ramp is computed from its start value,
+     * without any dependency between two samples, so the loop can be
+     * vectorised. Once the target is reached the rest of the buffer is filled
+     * with it.
+     * 
+     * @param dest          The buffer to write into
+     * @param numSamples    The number of values to write
+     */
+    void fillRamp (FloatType* dest, int numSamples) noexcept
+    {
+        auto numRampSamples = juce::jmin (numSamples, this->countdown);
+
+        if (numRampSamples > 0)
+        {
+            fillRampValues (dest, numRampSamples);
+            this->countdown -= numRampSamples;
+
+            if (this->isSmoothing())
+            {
+                this->currentValue = dest[numRampSamples - 1];
+            }
+            else
+            {
+                this->currentValue = this->target;
+                dest[numRampSamples - 1] = this->target;
+            }
+        }
+
+        juce::FloatVectorOperations::fill (dest + numRampSamples, this->target,
+                numSamples - numRampSamples);
+    }
+
     //==============================================================================
     /** THIS FUNCTION IS DEPRECATED.
 
@@ -256,6 +292,28 @@ private:
         this->currentValue *= (FloatType) std::pow (step, numSamples);
     }
 
+    //==============================================================================
+    template <typename T = SmoothingType>
+    LinearVoid<T> fillRampValues (FloatType* dest, int numSamples) noexcept
+    {
+        auto start = this->currentValue;
+
+        for (auto i = 0; i < numSamples; ++i)
+            dest[i] = start + step * (FloatType) (i + 1);
+    }
+
+    template <typename T = SmoothingType>
+    MultiplicativeVoid<T> fillRampValues (FloatType* dest, int numSamples) noexcept
+    {
+        auto value = this->currentValue;
+
+        for (auto i = 0; i < numSamples; ++i)
+        {
+            value *= step;
+            dest[i] = value;
+        }
+    }
+
     //==============================================================================
     FloatType step = FloatType();
     int stepsToTarget = 0;
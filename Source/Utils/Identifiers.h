@@ -25,24 +25,42 @@ namespace controls
 {
 
 /**
- * @brief Unique identifier for each controllable parameters 
+ * @brief The list of the controllable parameters, in the order of their dense
+ * index (see control::ParameterSnapshot::Index)
+ * 
+ * Each entry gives the name of the parameter, the control::ControllableParameter
+ * scale type of its values and its default resolution. It generates the
+ * identifier and the index of the parameter, and control::MidiBroker builds
+ * and registers the parameters from it. A new entry also needs its settings
+ * (CC, default, min and max) in the default configuration, then it is
+ * loaded, stored in the snapshots and the presets
  */
-const juce::Identifier  ATTACK("ATTACK");
-const juce::Identifier  DECAY("DECAY");
-const juce::Identifier  SUSTAIN("SUSTAIN");
-const juce::Identifier  RELEASE("RELEASE");
+#define RACIDERRY_CONTROLS(X)                   \
+    X(ATTACK,           logarithmic,    128)    \
+    X(DECAY,            logarithmic,    128)    \
+    X(SUSTAIN,          linear,         128)    \
+    X(RELEASE,          logarithmic,    128)    \
+    X(WAVEFORM_RATIO,   linear,         128)    \
+    X(GLIDE,            linear,         256)    \
+    X(CUTOFF,           logarithmic,    512)    \
+    X(RESONANCE,        linear,         128)    \
+    X(FILTER_MIX,       linear,         128)    \
+    X(ENV_MOD,          linear,         128)    \
+    X(ACCENT,           linear,         128)    \
+    X(ACCENT_DECAY,     logarithmic,    128)    \
+    X(SUB_LEVEL,        linear,         128)    \
+    X(UNISON_VOICES,    linear,         8)      \
+    X(UNISON_DETUNE,    linear,         128)
 
-const juce::Identifier  WAVEFORM_RATIO("WAVEFORM_RATIO");
-const juce::Identifier  GLIDE("GLIDE");
+/**
+ * @brief Unique identifier for each controllable parameters 
+ */
+#define RACIDERRY_DECLARE_IDENTIFIER(name, scale, resolution) const juce::Identifier name(#name);
+RACIDERRY_CONTROLS(RACIDERRY_DECLARE_IDENTIFIER)
+#undef RACIDERRY_DECLARE_IDENTIFIER
 
-const juce::Identifier  CUTOFF("CUTOFF");
-const juce::Identifier  RESONANCE("RESONANCE");
+// Not controllable yet
 const juce::Identifier  DRIVE("DRIVE");
-const juce::Identifier  ENV_MOD("ENV_MOD");
-const juce::Identifier  FILTER_MIX("FILTER_MIX");
-
-const juce::Identifier  ACCENT("ACCENT");
-const juce::Identifier  ACCENT_DECAY("ACCENT_DECAY");
 
 } //namespace controls
 
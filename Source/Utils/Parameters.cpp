@@ -9,13 +9,17 @@ constexpr auto CC = "CC";
 constexpr auto DEFAULT = "DEFAULT";
 constexpr auto MIN = "MIN";
 constexpr auto MAX = "MAX";
+constexpr auto RESOLUTION = "RESOLUTION";
 constexpr auto GLOBAL_CHANNEL = "GLOBAL_CHANNEL";
 constexpr auto SAVE_PATCH_CC = "SAVE_PATCH_CC";
+constexpr auto NUM_VOICES = "NUM_VOICES";
+constexpr auto NOISE_SEED = "NOISE_SEED";
+constexpr auto ABSOLUTE_CONTROLS = "ABSOLUTE_CONTROLS";
 
-const std::map<juce::Identifier, Parameter>   Parameter::loadParameters(
-        int& globalChannel, int& savePatchCC)
+Configuration Parameter::loadParameters()
 {
-    auto parametersMap = std::map<juce::Identifier, Parameter>();
+    auto configuration = Configuration();
+    auto& parametersMap = configuration.m_parameters;
     auto userParameterFile = juce::File(files::PARAMETERS);
     auto defaultParameterData = juce::var();
     auto userParameterData = juce::var();
@@ -39,18 +43,9 @@ const std::map<juce::Identifier, Parameter>   Parameter::loadParameters(
 
     // Which controls do we want to read from the JSON
     const juce::Identifier* controlsToLoad[] = {
-        &identifiers::controls::ATTACK,
-        &identifiers::controls::DECAY,
-        &identifiers::controls::SUSTAIN,
-        &identifiers::controls::RELEASE,
-        &identifiers::controls::WAVEFORM_RATIO,
-        &identifiers::controls::GLIDE,
-        &identifiers::controls::CUTOFF,
-        &identifiers::controls::RESONANCE,
-        &identifiers::controls::ENV_MOD,
-        &identifiers::controls::FILTER_MIX,
-        &identifiers::controls::ACCENT,
-        &identifiers::controls::ACCENT_DECAY,
+        #define RACIDERRY_IDENTIFIER_ADDRESS(name, scale, resolution) &identifiers::controls::name,
+        RACIDERRY_CONTROLS(RACIDERRY_IDENTIFIER_ADDRESS)
+        #undef RACIDERRY_IDENTIFIER_ADDRESS
     };
 
     // Populate the map with the parameters
@@ -73,10 +68,25 @@ const std::map<juce::Identifier, Parameter>   Parameter::loadParameters(
 
     jassert(defaultParameterData.hasProperty(GLOBAL_CHANNEL));
     jassert(defaultParameterData.hasProperty(SAVE_PATCH_CC));
-    globalChannel = defaultParameterData.getProperty(GLOBAL_CHANNEL, juce::var());
-    savePatchCC = defaultParameterData.getProperty(SAVE_PATCH_CC, juce::var());
+    configuration.m_globalChannel = defaultParameterData.getProperty(GLOBAL_CHANNEL, juce::var());
+    configuration.m_savePatchCC = defaultParameterData.getProperty(SAVE_PATCH_CC, juce::var());
 
-    return parametersMap;
+    // The number of voices can be overriden by the user
+    jassert(defaultParameterData.hasProperty(NUM_VOICES));
+    configuration.m_numVoices = userParameterData.getProperty(NUM_VOICES,
+            defaultParameterData.getProperty(NUM_VOICES, juce::var()));
+
+    // 0 means a random seed, any other value makes the noise reproducible
+    jassert(defaultParameterData.hasProperty(NOISE_SEED));
+    configuration.m_noiseSeed = userParameterData.getProperty(NOISE_SEED,
+            defaultParameterData.getProperty(NOISE_SEED, juce::var()));
+
+    // Relative (default) or absolute controller values
+    jassert(defaultParameterData.hasProperty(ABSOLUTE_CONTROLS));
+    configuration.m_absoluteControls = userParameterData.getProperty(ABSOLUTE_CONTROLS,
+            defaultParameterData.getProperty(ABSOLUTE_CONTROLS, juce::var()));
+
+    return configuration;
 }
 
 Parameter::Parameter(const juce::var& data)
@@ -90,6 +100,9 @@ Parameter::Parameter(const juce::var& data)
     m_default = float(data.getProperty(DEFAULT, juce::var()));
     m_min = float(data.getProperty(MIN, juce::var()));
     m_max = float(data.getProperty(MAX, juce::var()));
+
+    // The resolution is optional
+    m_resolution = int(data.getProperty(RESOLUTION, 0));
 }
 
 } // namespace parameters
@@ -29,7 +29,7 @@ namespace device
     const juce::AudioDeviceManager::AudioDeviceSetup PISOUND_SETUP({
         juce::String("pisound, ; Direct hardware device without any conversions"),
         juce::String("pisound, ; Direct hardware device without any conversions"),
-        192000,
+        48000,
         64,
         0,
         true,
@@ -40,7 +40,7 @@ namespace device
     const juce::AudioDeviceManager::AudioDeviceSetup DEV_SETUP({
         juce::String("Playback/recording through the PulseAudio sound server"),
         juce::String("Playback/recording through the PulseAudio sound server"),
-        96000,
+        48000,
         64,
         0,
         true,
@@ -51,29 +51,60 @@ namespace device
 
 namespace files
 {
-    const auto PRESETS_FILE = juce::String("presets.xml");
+    const auto PRESET_BANK_FILE = juce::String("presets.bank");
+    const auto LEGACY_PRESETS_FILE = juce::String("presets.xml");
+    const auto WAVETABLES_DIRECTORY = juce::String("wavetables");
     const auto PARAMETERS = juce::String("/etc/raciderry.json");
 }
 
+struct Configuration;
+
 struct Parameter {
     int     m_cc = -1;
     float   m_default = 0.f;
     float   m_min = 0.f;
     float   m_max = 0.f;
+    int     m_resolution = 0;   // 0 to keep the default of the parameter
 
     Parameter() = default;
 
-    static const std::map<juce::Identifier, Parameter>   loadParameters(
-            int& globalChannel, int& savePatchCC);
+    /**
+     * @brief Load the configuration, the user's file overriding the defaults
+     */
+    static Configuration loadParameters();
 private:
     Parameter(const juce::var& data);
 };
 
+/**
+ * @brief The content of the configuration file
+ */
+struct Configuration {
+    int                                     m_globalChannel = 0;
+    int                                     m_savePatchCC = 0;
+    int                                     m_numVoices = 1;
+    juce::int64                             m_noiseSeed = 0;
+    bool                                    m_absoluteControls = false;
+    // The settings of each controllable parameter
+    std::map<juce::Identifier, Parameter>   m_parameters;
+};
+
 namespace values
 {
     // Limiter values
     constexpr float         LIMITER_RELEASE_MS = 10.0;
     constexpr float         LIMITER_THRESHOLD_DB = -0.1;
+
+    // Only the filters run oversampled, to tame the aliasing of their saturation
+    constexpr int           FILTER_OVERSAMPLING_FACTOR = 4;
+
+    // The low memory builds define RACIDERRY_ANALYTIC_OSCILLATOR, the mono
+    // voice then computes its waveforms instead of reading the wavetables
+#if RACIDERRY_ANALYTIC_OSCILLATOR
+    constexpr bool          ANALYTIC_OSCILLATOR = true;
+#else
+    constexpr bool          ANALYTIC_OSCILLATOR = false;
+#endif
 }
 
 
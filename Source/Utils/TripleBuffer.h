@@ -0,0 +1,101 @@
+/*
+  ==============================================================================
+
+    TripleBuffer.h
+    Created: 17 Oct 2026 9:14:05pm
+    Author:  maxime
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <type_traits>
+
+#include <JuceHeader.h>
+
+namespace utils {
+
+/**
+ * @class utils::TripleBuffer
+ * @brief A wait-free single producer, single consumer holder of the latest
+ * value of a trivially copyable type
+ *
+ * The writer and the reader each own one of the three buffers, the third one
+ * is exchanged atomically between them. The writer never waits for the
+ * reader and can publish as often as it wants, the reader always gets the
+ * latest complete value and never a torn one. Values published between two
+ * reads are skipped.
+ *
+ * @tparam T A trivially copyable type
+ */
+template <typename T>
+class TripleBuffer
+{
+public:
+    static_assert(std::is_trivially_copyable<T>::value,
+            "The TripleBuffer only holds trivially copyable types");
+
+    /**
+     * @brief Build the buffer, the three copies hold the initial value and
+     * nothing is pending
+     */
+    explicit TripleBuffer(const T& initialValue = T()) noexcept
+        : m_front(0),
+          m_back(2),
+          m_middle(1)
+    {
+        m_buffers.fill(initialValue);
+    }
+
+//==============================================================================
+    /**
+     * @brief Publish a new value
+     * @note Must only be called by the producer thread
+     */
+    void write(const T& value) noexcept
+    {
+        m_buffers[m_back] = value;
+        m_back = juce::uint8(m_middle.exchange(juce::uint8(m_back | DIRTY_BIT),
+                std::memory_order_acq_rel) & INDEX_MASK);
+    }
+
+    /**
+     * @brief Test if a value was published since the last read()
+     */
+    bool hasNewValue() const noexcept
+    {
+        return (m_middle.load(std::memory_order_acquire) & DIRTY_BIT) != 0;
+    }
+
+    /**
+     * @brief Get the latest published value
+     *
+     * The reference stays valid and unchanged until the next call
+     * @note Must only be called by the consumer thread
+     */
+    const T& read() noexcept
+    {
+        if (hasNewValue())
+        {
+            m_front = juce::uint8(m_middle.exchange(m_front, std::memory_order_acq_rel)
+                    & INDEX_MASK);
+        }
+
+        return m_buffers[m_front];
+    }
+
+private:
+    static constexpr juce::uint8 INDEX_MASK = 0x3;
+    static constexpr juce::uint8 DIRTY_BIT = 0x4;
+
+//==============================================================================
+    std::array<T, 3>                        m_buffers;
+    juce::uint8                             m_front;    // Consumer only
+    juce::uint8                             m_back;     // Producer only
+    std::atomic<juce::uint8>                m_middle;   // Index + dirty bit
+};
+
+} // namespace utils
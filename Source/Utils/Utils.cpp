@@ -10,7 +10,9 @@
 
 #include "Utils.h"
 
+#include <algorithm>
 #include <random>
+#include <vector>
 
 #include <JuceHeader.h>
 
@@ -97,6 +99,52 @@ void loadWavetableFromBinaryWaveFile(
     reader->read(&bufferToAllocate, 0, reader->lengthInSamples, 0, true, true);
 }
 
+int getNumMipmapLevels(int tableSize)
+{
+    jassert(juce::isPowerOfTwo(tableSize) && tableSize >= 4);
+
+    // From tableSize / 4 harmonics to a single one
+    return juce::roundToInt(std::log2(tableSize)) - 1;
+}
+
+void buildMipmaps(juce::AudioSampleBuffer& wavetable)
+{
+    jassert(wavetable.getNumChannels() == 1);
+
+    auto tableSize = wavetable.getNumSamples();
+    auto numLevels = getNumMipmapLevels(tableSize);
+    auto fft = juce::dsp::FFT(juce::roundToInt(std::log2(tableSize)));
+
+    // The fft works in place, and needs twice the table size
+    auto spectrum = std::vector<float>(size_t(2 * tableSize), 0.f);
+    auto level = std::vector<float>(size_t(2 * tableSize), 0.f);
+
+    std::copy_n(wavetable.getReadPointer(0), tableSize, spectrum.begin());
+    fft.performRealOnlyForwardTransform(spectrum.data());
+
+    wavetable.setSize(numLevels, tableSize, true);
+
+    for (auto l = 0; l < numLevels; ++l)
+    {
+        auto maxHarmonic = tableSize >> (l + 2);
+        level = spectrum;
+
+        // The bins are interleaved complex values, the negative frequencies
+        // being mirrored in the upper half
+        for (auto bin = 0; bin < tableSize; ++bin)
+        {
+            if (std::min(bin, tableSize - bin) > maxHarmonic)
+            {
+                level[size_t(2 * bin)] = 0.f;
+                level[size_t(2 * bin + 1)] = 0.f;
+            }
+        }
+
+        fft.performRealOnlyInverseTransform(level.data());
+        wavetable.copyFrom(l, 0, level.data(), tableSize);
+    }
+}
+
 } // namespace waveform
 
 }//namespace utils
\ No newline at end of file
@@ -43,6 +43,29 @@ void loadWavetableFromBinaryWaveFile(
         const void* sourceData,
         size_t sourceDataSize);
 
+/**
+ * @brief Get the number of mipmap levels built by buildMipmaps() for a table
+ * of the given size
+ */
+int getNumMipmapLevels(int tableSize);
+
+/**
+ * @brief Replace a single cycle wavetable with its per-octave, band-limited
+ * mipmap
+ *
+ * Every level is stored in its own channel. Level 0 keeps the harmonics up to
+ * a quarter of the table size, and each following level keeps half the
+ * harmonics of the previous one, down to a pure sine. This gives one octave of
+ * headroom, so an oscillator crossfading the levels L and L + 1 while its
+ * table delta is in [2^L; 2^(L+1)[ never aliases.
+ *
+ * The band-limiting is done in the frequency domain, so the table size must
+ * be a power of two. This allocates, and should be called at load time.
+ *
+ * @param wavetable A mono wavetable, resized to getNumMipmapLevels() channels
+ */
+void buildMipmaps(juce::AudioSampleBuffer& wavetable);
+
 } // namespace waveform
 
 }//namespace utils